@@ -0,0 +1,108 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "benchmark_report.h"
+
+static double seconds_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+static int compare_doubles(const void *a, const void *b){
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int benchmark_parse_arguments(BenchmarkReport *report, const char *name, int argc, char **argv){
+    report->name = name;
+    report->repetitions = 5;
+    report->json = 0;
+    report->quick = 0;
+    report->printed = 0;
+    int option;
+    while((option = getopt(argc, argv, "jqr:")) != -1){
+        switch(option){
+            case 'j': report->json = 1; break;
+            case 'q': report->quick = 1; break;
+            case 'r': report->repetitions = (unsigned int)atoi(optarg); break;
+            default: report->repetitions = 0; break;
+        }
+    }
+    if(report->repetitions < 1 || optind != argc){
+        fprintf(stderr, "Usage: %s [-j] [-q] [-r repetitions]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+double benchmark_time(benchmark_function function, void *context, unsigned int repetitions){
+    double *times = malloc(repetitions*sizeof(double));
+    if(!times) return 0;
+    function(context);
+    for(unsigned int r=0;r<repetitions;r++){
+        double start = seconds_now();
+        function(context);
+        times[r] = seconds_now() - start;
+    }
+    qsort(times, repetitions, sizeof(double), compare_doubles);
+    double median = (repetitions % 2) ? times[repetitions/2] : 0.5*(times[repetitions/2 - 1] + times[repetitions/2]);
+    free(times);
+    return median;
+}
+
+void benchmark_begin(BenchmarkReport *report){
+    if(report->json){
+        printf("{\"benchmark\": \"%s\", \"repetitions\": %u, \"cpus\": %ld, \"results\": [", report->name, report->repetitions, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    else{
+        printf("%s (median of %u runs)\n", report->name, report->repetitions);
+        printf("%-54s %10s %9s %7s %12s %10s %10s %12s\n", "function", "rows", "features", "passes", "time (s)", "ns/row", "GFLOP/s", "GB/s");
+    }
+    fflush(stdout);
+}
+
+void benchmark_print(BenchmarkReport *report, const BenchmarkResult *result){
+    double seconds = (result->seconds > 0) ? result->seconds : 1e-12;
+    double ns_per_row = seconds*1e9/((double)result->rows*result->passes);
+    double gflops = result->flops/seconds*1e-9;
+    double bytes_per_second = result->bytes/seconds;
+    if(report->json){
+        printf("%s\n  {\"function\": \"%s\", \"rows\": %zu, \"features\": %zu, \"passes\": %u, \"seconds\": %.9g, "
+               "\"ns_per_row\": %.6g, \"gflops\": %.6g, \"bytes_per_second\": %.6g}",
+               report->printed ? "," : "", result->function, result->rows, result->features, result->passes, 
+               result->seconds, ns_per_row, gflops, bytes_per_second);
+    }
+    else{
+        printf("%-54s %10zu %9zu %7u %12.6f %10.3f %10.3f %12.3f\n", result->function, result->rows, result->features, 
+               result->passes, result->seconds, ns_per_row, gflops, bytes_per_second*1e-9);
+    }
+    report->printed++;
+    fflush(stdout);
+}
+
+void benchmark_end(BenchmarkReport *report){
+    if(report->json) printf("\n]}\n");
+}
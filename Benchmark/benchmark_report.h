@@ -0,0 +1,110 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_REPORT_H
+#define BENCHMARK_REPORT_H
+
+#include <stddef.h>
+
+/*
+ * Shared timing and reporting for the per model benchmarks (LinearRegression/benchmark.c, 
+ * MultipleLinearRegression/benchmark.c, ...), so that all of them accept the same options and 
+ * print the same table or JSON document.
+ */
+
+typedef struct {
+const char *function;   // entry point measured
+size_t rows;
+size_t features;
+unsigned int passes;    // passes over the data in one call (iterations or epochs), 1 for one sweep
+double seconds;         // median time of one call
+double flops;           // floating point operations of one call, counted from the algorithm
+double bytes;           // bytes of data one call streams from and to memory, counted from the algorithm
+}BenchmarkResult;
+
+typedef struct {
+const char *name;           // benchmark name in the report
+unsigned int repetitions;   // timed calls per case, the median is reported
+int json;                   // 1 for JSON output, 0 for a table
+int quick;                  // 1 to run the small sizes only
+size_t printed;             // results printed so far
+}BenchmarkReport;
+
+typedef void (*benchmark_function)(void *context);
+
+
+/*
+ * Function: benchmark_parse_arguments
+ * ----------------------------
+ */
+int benchmark_parse_arguments(BenchmarkReport *report, const char *name, int argc, char **argv);
+/* This function fills `report` from the command line shared by all benchmarks:
+ *    -j  print the results as one JSON document instead of a table
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case (default 5)
+ *
+ * Returns:
+ *    - `0` if the options are valid.
+ *    - `1` if they are not, after printing the usage.
+ */
+
+
+/*
+ * Function: benchmark_time
+ * ----------------------------
+ */
+double benchmark_time(benchmark_function function, void *context, unsigned int repetitions);
+/* This function calls `function(context)` once to warm caches and page tables up, then 
+ * `repetitions` more times, and returns the median time of the timed calls in seconds. The 
+ * median is used rather than the mean so that one call disturbed by the system does not move 
+ * the result.
+ */
+
+
+/*
+ * Function: benchmark_begin
+ * ----------------------------
+ */
+void benchmark_begin(BenchmarkReport *report);
+/* This function prints the table header or the opening of the JSON document.
+ */
+
+
+/*
+ * Function: benchmark_print
+ * ----------------------------
+ */
+void benchmark_print(BenchmarkReport *report, const BenchmarkResult *result);
+/* This function prints one result with its derived rates:
+ *    - ns_per_row: seconds / (rows * passes), the cost of one row in one pass
+ *    - gflops: flops / seconds / 10^9
+ *    - bytes_per_second: bytes / seconds
+ */
+
+
+/*
+ * Function: benchmark_end
+ * ----------------------------
+ */
+void benchmark_end(BenchmarkReport *report);
+/* This function closes the JSON document (nothing for a table).
+ */
+
+#endif // BENCHMARK_REPORT_H
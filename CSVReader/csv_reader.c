@@ -0,0 +1,441 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "csv_reader.h"
+
+// Column destinations in CSVLayout.destination
+#define CSV_SKIP (-1)
+#define CSV_TARGET (-2)
+
+// Where every column of a row goes, shared by all threads
+typedef struct {
+    char delimiter;
+    size_t number_of_columns_used;  // columns after this one are never looked at
+    long *destination;              // per column: CSV_SKIP, CSV_TARGET or the x_data column
+    gsl_matrix *x_data;
+    gsl_vector *y_data;
+    int add_bias_column;
+}CSVLayout;
+
+// Work description for one thread, [begin, end) always holds whole lines
+typedef struct {
+    const char *begin;
+    const char *end;
+    size_t number_of_rows;  // pass 1 result
+    size_t first_row;       // pass 2 input
+    CSVLayout *layout;
+    unsigned int status;
+}CSVRange;
+
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+void csv_read_options_default(CSVReadOptions *options){
+    options->delimiter = ',';
+    options->skip_header = 0;
+    options->feature_columns = NULL;
+    options->number_of_feature_columns = 0;
+    options->target_column = CSV_LAST_COLUMN;
+    options->add_bias_column = 0;
+    options->number_of_threads = 0;
+}
+
+static int is_blank_line(const char *line, const char *line_end){
+    for(;line<line_end;line++){
+        if(*line!=' '&&*line!='\t'&&*line!='\r') return 0;
+    }
+    return 1;
+}
+
+static const char *line_end_of(const char *line, const char *end){
+    const char *newline = memchr(line, '\n', (size_t)(end - line));
+    return newline ? newline : end;
+}
+
+/*
+Parses one number starting at p, returns the position after it or NULL.
+Plain decimals with at most 15 significant digits and a small exponent are exact doubles times an
+exact power of ten, so one multiplication or division gives the correctly rounded result
+(Clinger's fast path). Everything else, including tokens the fast path stops inside of (e.g. the 
+"x" of "0x1A"), goes through strtod.
+ */
+static const char *csv_parse_double(const char *p, const char *end, char delimiter, double *value){
+    while(p<end && (*p==' ' || (*p=='\t' && delimiter!='\t'))) p++;
+    const char *start = p;
+
+    int negative = 0;
+    if(p<end && (*p=='+'||*p=='-')){
+        negative = (*p=='-');
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int significant_digits = 0, exponent = 0, any_digit = 0, truncated = 0;
+    for(;p<end && *p>='0' && *p<='9';p++){
+        any_digit = 1;
+        if(significant_digits < 19){
+            mantissa = mantissa*10 + (uint64_t)(*p-'0');
+            if(mantissa != 0) significant_digits++;
+        }
+        else{
+            exponent++;
+            truncated = 1;
+        }
+    }
+    if(p<end && *p=='.'){
+        for(p++;p<end && *p>='0' && *p<='9';p++){
+            any_digit = 1;
+            if(significant_digits < 19){
+                mantissa = mantissa*10 + (uint64_t)(*p-'0');
+                if(mantissa != 0) significant_digits++;
+                exponent--;
+            }
+            else truncated = 1;
+        }
+    }
+    if(any_digit && p<end && (*p=='e'||*p=='E')){
+        const char *exponent_start = p++;
+        int exponent_negative = 0, exponent_value = 0, exponent_digit = 0;
+        if(p<end && (*p=='+'||*p=='-')){
+            exponent_negative = (*p=='-');
+            p++;
+        }
+        for(;p<end && *p>='0' && *p<='9';p++){
+            exponent_digit = 1;
+            if(exponent_value < 100000) exponent_value = exponent_value*10 + (*p-'0');
+        }
+        if(!exponent_digit) p = exponent_start; // "1e" is the number 1 followed by junk
+        else exponent += exponent_negative ? -exponent_value : exponent_value;
+    }
+
+    int field_ends = (p==end || *p==delimiter || *p==' ' || *p=='\t' || *p=='\r' || *p=='\n');
+    if(field_ends && any_digit && !truncated && significant_digits <= 15 && exponent >= -22 && exponent <= 22){
+        double result = (double)mantissa;
+        if(exponent > 0) result *= powers_of_ten[exponent];
+        else if(exponent < 0) result /= powers_of_ten[-exponent];
+        *value = negative ? -result : result;
+        return p;
+    }
+
+    // Slow path, strtod needs a terminated copy since the mapping has no terminator
+    const char *token_end = start;
+    while(token_end<end && *token_end!=delimiter && *token_end!='\n' && *token_end!='\r') token_end++;
+    char local_buffer[64];
+    size_t length = (size_t)(token_end - start);
+    if(length == 0) return NULL;
+    // Long tokens (many digits) are rare, they get a heap copy
+    char *buffer = length < sizeof(local_buffer) ? local_buffer : malloc(length + 1);
+    if(!buffer) return NULL;
+    memcpy(buffer, start, length);
+    buffer[length] = '\0';
+    char *parsed_end;
+    *value = strtod(buffer, &parsed_end);
+    size_t parsed = (size_t)(parsed_end - buffer);
+    if(buffer != local_buffer) free(buffer);
+    if(parsed == 0) return NULL;
+    return start + parsed;
+}
+
+static void *csv_count_rows(void *argument){
+    CSVRange *range = (CSVRange *)argument;
+    size_t rows = 0;
+    for(const char *line=range->begin;line<range->end;){
+        const char *line_end = line_end_of(line, range->end);
+        if(!is_blank_line(line, line_end)) rows++;
+        line = line_end + 1;
+    }
+    range->number_of_rows = rows;
+    return NULL;
+}
+
+static unsigned int csv_parse_line(CSVLayout *layout, const char *line, const char *line_end, size_t row){
+    gsl_matrix *x_data = layout->x_data;
+    double *x_row = x_data->data + row*x_data->tda;
+    if(layout->add_bias_column) x_row[0] = 1.0;
+
+    const char *p = line;
+    size_t column = 0;
+    while(column < layout->number_of_columns_used){
+        long destination = layout->destination[column];
+        if(destination == CSV_SKIP){
+            p = memchr(p, layout->delimiter, (size_t)(line_end - p));
+            if(!p) return 2; // row has fewer columns than selected
+            p++;
+            column++;
+            continue;
+        }
+
+        double value;
+        p = csv_parse_double(p, line_end, layout->delimiter, &value);
+        if(!p) return 2; // not a number
+        while(p<line_end && (*p==' '||*p=='\r'||(*p=='\t'&&layout->delimiter!='\t'))) p++;
+        if(destination == CSV_TARGET) layout->y_data->data[row*layout->y_data->stride] = value;
+        else x_row[destination] = value;
+        column++;
+
+        if(p == line_end) break;
+        if(*p != layout->delimiter) return 2; // junk after the number
+        p++;
+    }
+    return (column < layout->number_of_columns_used) ? 2 : 0;
+}
+
+static void *csv_parse_rows(void *argument){
+    CSVRange *range = (CSVRange *)argument;
+    size_t row = range->first_row;
+    for(const char *line=range->begin;line<range->end;){
+        const char *line_end = line_end_of(line, range->end);
+        if(!is_blank_line(line, line_end)){
+            if(csv_parse_line(range->layout, line, line_end, row) != 0){
+                range->status = 2;
+                return NULL;
+            }
+            row++;
+        }
+        line = line_end + 1;
+    }
+    return NULL;
+}
+
+// Runs worker on every range, range 0 on the calling thread
+static unsigned int csv_run_threads(void *(*worker)(void *), CSVRange *ranges, unsigned int number_of_threads){
+    pthread_t *threads = malloc(number_of_threads*sizeof(pthread_t));
+    if(!threads) return 1;
+    unsigned int started = 1;
+    for(;started<number_of_threads;started++){
+        if(pthread_create(&threads[started], NULL, worker, &ranges[started]) != 0) break;
+    }
+    worker(&ranges[0]);
+    for(unsigned int t=1;t<started;t++){
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    return (started == number_of_threads) ? 0 : 1;
+}
+
+// Maps the file and splits the data part into per thread ranges on line boundaries
+static unsigned int csv_open(const char *path, CSVReadOptions *options, void **mapping, size_t *mapping_size, CSVRange **ranges, unsigned int *number_of_threads){
+    int file = open(path, O_RDONLY);
+    if(file < 0) return 1;
+    struct stat file_status;
+    if(fstat(file, &file_status) != 0){
+        close(file);
+        return 1;
+    }
+    *mapping_size = (size_t)file_status.st_size;
+    if(*mapping_size == 0){
+        close(file);
+        return 2; // no data rows
+    }
+    *mapping = mmap(NULL, *mapping_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if(*mapping == MAP_FAILED) return 1;
+    madvise(*mapping, *mapping_size, MADV_SEQUENTIAL);
+
+    const char *begin = (const char *)*mapping,
+               *end = begin + *mapping_size;
+    if(options->skip_header){
+        begin = line_end_of(begin, end);
+        if(begin < end) begin++;
+    }
+
+    unsigned int threads = options->number_of_threads;
+    if(threads == 0){
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    // Not worth a thread below 1 MB each
+    size_t length = (size_t)(end - begin);
+    if(threads > length/(1<<20) + 1) threads = (unsigned int)(length/(1<<20) + 1);
+
+    *ranges = calloc(threads, sizeof(CSVRange));
+    if(!*ranges){
+        munmap(*mapping, *mapping_size);
+        return 1;
+    }
+    const char *range_begin = begin;
+    for(unsigned int t=0;t<threads;t++){
+        const char *range_end = end;
+        if(t+1 < threads){
+            range_end = begin + (length/threads)*(t+1);
+            if(range_end < range_begin) range_end = range_begin;
+            // Move the cut behind the next newline so no line is split
+            if(range_end > begin && range_end[-1] != '\n'){
+                range_end = line_end_of(range_end, end);
+                if(range_end < end) range_end++;
+            }
+        }
+        (*ranges)[t].begin = range_begin;
+        (*ranges)[t].end = range_end;
+        range_begin = range_end;
+    }
+    *number_of_threads = threads;
+    return 0;
+}
+
+// Number of columns of the first data row, 0 if there is none
+static size_t csv_count_columns(CSVRange *ranges, unsigned int number_of_threads, char delimiter){
+    for(unsigned int t=0;t<number_of_threads;t++){
+        for(const char *line=ranges[t].begin;line<ranges[t].end;){
+            const char *line_end = line_end_of(line, ranges[t].end);
+            if(!is_blank_line(line, line_end)){
+                size_t columns = 1;
+                for(const char *p=line;p<line_end;p++){
+                    if(*p==delimiter) columns++;
+                }
+                return columns;
+            }
+            line = line_end + 1;
+        }
+    }
+    return 0;
+}
+
+// Resolves the target column (CSV_NO_TARGET if none) and checks the selection against the file
+static unsigned int csv_resolve_columns(CSVReadOptions *options, size_t number_of_columns, long *target_column, size_t *number_of_features){
+    if(number_of_columns == 0) return 2;
+    long target = options->target_column;
+    if(target == CSV_LAST_COLUMN) target = (long)number_of_columns - 1;
+    else if(target != CSV_NO_TARGET && (target < 0 || (size_t)target >= number_of_columns)) return 2;
+
+    size_t features;
+    if(options->feature_columns){
+        for(size_t i=0;i<options->number_of_feature_columns;i++){
+            if(options->feature_columns[i] >= number_of_columns) return 2;
+            // A column can only be read into one place
+            if(target != CSV_NO_TARGET && options->feature_columns[i] == (size_t)target) return 2;
+            for(size_t k=0;k<i;k++){
+                if(options->feature_columns[k] == options->feature_columns[i]) return 2;
+            }
+        }
+        features = options->number_of_feature_columns;
+    }
+    else features = number_of_columns - ((target == CSV_NO_TARGET) ? 0 : 1);
+
+    *target_column = target;
+    *number_of_features = features + (options->add_bias_column ? 1 : 0);
+    return 0;
+}
+
+unsigned int csv_dimensions(const char *path, CSVReadOptions *options, size_t *number_of_rows, size_t *number_of_features){
+    void *mapping;
+    size_t mapping_size;
+    CSVRange *ranges;
+    unsigned int number_of_threads;
+    unsigned int status = csv_open(path, options, &mapping, &mapping_size, &ranges, &number_of_threads);
+    if(status != 0) return status;
+
+    long target_column;
+    status = csv_resolve_columns(options, csv_count_columns(ranges, number_of_threads, options->delimiter), &target_column, number_of_features);
+    if(status == 0) status = csv_run_threads(csv_count_rows, ranges, number_of_threads);
+    if(status == 0){
+        *number_of_rows = 0;
+        for(unsigned int t=0;t<number_of_threads;t++) *number_of_rows += ranges[t].number_of_rows;
+        if(*number_of_rows == 0) status = 2;
+    }
+
+    free(ranges);
+    munmap(mapping, mapping_size);
+    return status;
+}
+
+unsigned int csv_read(const char *path, CSVReadOptions *options, gsl_matrix *x_data, gsl_vector *y_data){
+    void *mapping;
+    size_t mapping_size;
+    CSVRange *ranges;
+    unsigned int number_of_threads;
+    unsigned int status = csv_open(path, options, &mapping, &mapping_size, &ranges, &number_of_threads);
+    if(status != 0) return status;
+
+    CSVLayout layout;
+    layout.destination = NULL;
+    long target_column;
+    size_t number_of_features;
+    size_t number_of_columns = csv_count_columns(ranges, number_of_threads, options->delimiter);
+    status = csv_resolve_columns(options, number_of_columns, &target_column, &number_of_features);
+    if(status == 0 && (number_of_features != x_data->size2 || (target_column != CSV_NO_TARGET && (!y_data || y_data->size != x_data->size1)))) status = 2;
+    if(status != 0) goto cleanup;
+
+    // Column -> destination table, only as wide as the last column we need
+    layout.destination = malloc(number_of_columns*sizeof(long));
+    if(!layout.destination){
+        status = 1;
+        goto cleanup;
+    }
+    size_t bias_offset = options->add_bias_column ? 1 : 0;
+    layout.number_of_columns_used = 0;
+    for(size_t column=0;column<number_of_columns;column++) layout.destination[column] = CSV_SKIP;
+    if(options->feature_columns){
+        for(size_t i=0;i<options->number_of_feature_columns;i++){
+            layout.destination[options->feature_columns[i]] = (long)(i + bias_offset);
+            if(options->feature_columns[i] + 1 > layout.number_of_columns_used) layout.number_of_columns_used = options->feature_columns[i] + 1;
+        }
+    }
+    else{
+        size_t feature = bias_offset;
+        for(size_t column=0;column<number_of_columns;column++){
+            if((long)column != target_column) layout.destination[column] = (long)feature++;
+        }
+        layout.number_of_columns_used = number_of_columns;
+    }
+    if(target_column != CSV_NO_TARGET){
+        layout.destination[target_column] = CSV_TARGET;
+        if((size_t)target_column + 1 > layout.number_of_columns_used) layout.number_of_columns_used = (size_t)target_column + 1;
+    }
+    layout.delimiter = options->delimiter;
+    layout.x_data = x_data;
+    layout.y_data = y_data;
+    layout.add_bias_column = options->add_bias_column;
+
+    // Pass 1: rows per range, then the first row of every range
+    status = csv_run_threads(csv_count_rows, ranges, number_of_threads);
+    if(status != 0) goto cleanup;
+    size_t number_of_rows = 0;
+    for(unsigned int t=0;t<number_of_threads;t++){
+        ranges[t].first_row = number_of_rows;
+        ranges[t].layout = &layout;
+        ranges[t].status = 0;
+        number_of_rows += ranges[t].number_of_rows;
+    }
+    if(number_of_rows != x_data->size1){
+        status = 2;
+        goto cleanup;
+    }
+
+    // Pass 2: parse straight into the final rows
+    status = csv_run_threads(csv_parse_rows, ranges, number_of_threads);
+    for(unsigned int t=0;status==0 && t<number_of_threads;t++) status = ranges[t].status;
+
+cleanup:
+    free(layout.destination);
+    free(ranges);
+    munmap(mapping, mapping_size);
+    return status;
+}
@@ -0,0 +1,120 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <stddef.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+// Special values for CSVReadOptions.target_column
+#define CSV_LAST_COLUMN (-1)
+#define CSV_NO_TARGET (-2)
+
+typedef struct {
+char delimiter;                     // field separator, e.g. ',' or '\t'
+int skip_header;                    // 1 if the first line holds column names
+size_t *feature_columns;            // zero based distinct columns to use as features, not the target; NULL for every column except the target
+size_t number_of_feature_columns;   // length of feature_columns
+long target_column;                 // zero based target column, CSV_LAST_COLUMN or CSV_NO_TARGET
+int add_bias_column;                // 1 to put a column of ones in front of the features (the intercept column)
+unsigned int number_of_threads;     // 0 uses every online core
+}CSVReadOptions;
+
+
+/*
+ * Function: csv_read_options_default
+ * ----------------------------
+ */
+void csv_read_options_default(CSVReadOptions *options);
+/* This function fills `options` with the defaults: comma separated, no header line, every column 
+ * except the last one is a feature, the last one is the target, no bias column, one thread per core.
+ *
+ * Arguments:
+ *    - options: A pointer to the `CSVReadOptions` to initialise.
+ */
+
+
+/*
+ * Function: csv_dimensions
+ * ----------------------------
+ */
+unsigned int csv_dimensions(const char *path, CSVReadOptions *options, size_t *number_of_rows, size_t *number_of_features);
+/* This function scans a delimited text file and reports the sizes needed to hold it, so the caller 
+ * can allocate the `gsl_matrix`/`gsl_vector` passed to `csv_read`:
+ *    x_data = gsl_matrix_alloc(number_of_rows, number_of_features);
+ *    y_data = gsl_vector_alloc(number_of_rows);
+ * Blank lines and the header line (if `skip_header` is set) are not counted as rows. The number of 
+ * columns is taken from the first data row. Rows are counted by all threads in parallel.
+ *
+ * Arguments:
+ *    - path: The path of the text file.
+ *    - options: The `CSVReadOptions` that will be used to read the file.
+ *    - number_of_rows: Receives the number of data rows.
+ *    - number_of_features: Receives the number of columns of x_data (selected features plus the 
+ *      bias column if requested).
+ *
+ * Returns:
+ *    - `0` if the file was scanned.
+ *    - `1` if there was a system error (e.g., the file could not be opened or mapped, thread failure).
+ *    - `2` if the file has no data rows or the options name columns that do not exist, name a 
+ *      feature column twice or also as the target.
+ */
+
+
+/*
+ * Function: csv_read
+ * ----------------------------
+ */
+unsigned int csv_read(const char *path, CSVReadOptions *options, gsl_matrix *x_data, gsl_vector *y_data);
+/* This function reads a delimited text file (CSV, TSV, ...) straight into a preallocated 
+ * `gsl_matrix` of features and `gsl_vector` of targets, ready for `mlr_train`, 
+ * `refine_mlr_gradient_descent` or `logistic_regression_train`.
+ *
+ * The file is memory mapped and cut into one byte range per thread. Every range boundary is moved 
+ * forward to the next newline so that no line is split between two threads. The file is read twice:
+ *    1. every thread counts the rows in its range; a prefix sum over these counts tells every 
+ *       thread the index of its first row,
+ *    2. every thread parses its range and writes the values directly into their final rows.
+ * Numbers are parsed by a fast decimal parser which gives correctly rounded results for plain 
+ * decimals of up to 15 significant digits; every other token (longer numbers, inf, nan, hex such 
+ * as 0x1A) is handed to strtod.
+ *
+ * Arguments:
+ *    - path: The path of the text file.
+ *    - options: The `CSVReadOptions` describing the layout and column selection.
+ *    - x_data: A `gsl_matrix` with exactly one row per data row and one column per selected 
+ *      feature (plus the bias column). Only the columns selected by the options are parsed.
+ *    - y_data: A `gsl_vector` with one element per data row, or NULL when `target_column` is 
+ *      CSV_NO_TARGET.
+ *
+ * Returns:
+ *    - `0` if the file was read.
+ *    - `1` if there was a system error (e.g., the file could not be opened or mapped, thread failure).
+ *    - `2` if the file does not match the options or matrix sizes, the options name a feature 
+ *      column twice or also as the target, or a selected field is not a number.
+ *
+ * Notes:
+ *    - Unselected columns may hold anything (e.g. text). Lines may end with "\n" or "\r\n".
+ *    - The calling program must be linked with `-pthread`.
+ */
+
+#endif // CSV_READER_H
@@ -0,0 +1,87 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "csv_reader.h"
+#include "../MultipleLinearRegression/multiple_linear_regression.h"
+
+int main() {
+    // Write a small example file: a text column we do not want, two features and the target
+    FILE *file = fopen("example.csv", "w");
+    if (!file) {
+        printf("Could not create example.csv\n");
+        return 1;
+    }
+    fprintf(file, "city,size,rooms,price\n");
+    fprintf(file, "a,50,2,152\n");
+    fprintf(file, "b,65,3,196\n");
+    fprintf(file, "c,80,3,238\n");
+    fprintf(file, "d,100,4,301\n");
+    fprintf(file, "e,120,5,362\n");
+    fclose(file);
+
+    // Skip the header, use "size" and "rooms" as features, "price" as target, prepend the intercept column
+    CSVReadOptions options;
+    csv_read_options_default(&options);
+    size_t feature_columns[2] = {1, 2};
+    options.skip_header = 1;
+    options.feature_columns = feature_columns;
+    options.number_of_feature_columns = 2;
+    options.target_column = 3;
+    options.add_bias_column = 1;
+
+    size_t number_of_rows, number_of_features;
+    unsigned int result = csv_dimensions("example.csv", &options, &number_of_rows, &number_of_features);
+    if (result != 0) {
+        printf("Could not scan example.csv, error code: %u\n", result);
+        return 1;
+    }
+
+    gsl_matrix *x_data = gsl_matrix_alloc(number_of_rows, number_of_features);
+    gsl_vector *y_data = gsl_vector_alloc(number_of_rows);
+    gsl_vector *coeff_set = gsl_vector_alloc(number_of_features);
+
+    result = csv_read("example.csv", &options, x_data, y_data);
+    if (result != 0) {
+        printf("Could not read example.csv, error code: %u\n", result);
+    } else {
+        printf("Read %zu rows:\n", number_of_rows);
+        for (size_t i = 0; i < number_of_rows; i++) {
+            printf("x = [%.0f %.0f %.0f]  y = %.0f\n", gsl_matrix_get(x_data, i, 0), gsl_matrix_get(x_data, i, 1), gsl_matrix_get(x_data, i, 2), gsl_vector_get(y_data, i));
+        }
+
+        result = mlr_train(x_data, y_data, coeff_set, 0.01);
+        if (result == 0) {
+            printf("\nCoefficients:\n");
+            for (size_t i = 0; i < coeff_set->size; i++) {
+                printf("Coefficient %zu: %.4f\n", i, gsl_vector_get(coeff_set, i));
+            }
+        }
+    }
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(coeff_set);
+    return 0;
+}
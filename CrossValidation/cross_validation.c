@@ -0,0 +1,392 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "cross_validation.h"
+#include "../LogisticRegression/logistic_regression.h"
+
+// Rows gathered per tile: 256 rows of a few dozen features stay in L1/L2 while they are used
+#define CROSS_VALIDATION_TILE_ROWS 256
+
+// State shared by all tasks of one cross_validation_run
+typedef struct {
+gsl_matrix *x_data;
+gsl_vector *y_data;
+CrossValidationParameters *grid;
+CrossValidationMetrics *metrics;
+size_t number_of_folds;
+size_t *order;                  // permutation of the row indices
+size_t *fold_start;             // fold f is order[fold_start[f] .. fold_start[f + 1])
+gsl_matrix **fold_x_trans_x;    // MLR: lower triangle of X_f^T X_f per fold
+gsl_vector **fold_x_trans_y;    // MLR: X_f^T y_f per fold
+gsl_matrix *x_trans_x;          // MLR: lower triangle of X^T X
+gsl_vector *x_trans_y;          // MLR: X^T y
+}CrossValidationRun;
+
+// One grid point on one fold (or, for the MLR fold pass, one fold)
+typedef struct {
+CrossValidationRun *run;
+size_t grid_index;
+size_t fold;
+unsigned int status;            // 1 if the task could not allocate its buffers
+}CrossValidationTask;
+
+// Per task scratch: one tile of rows, their targets and one value per row
+typedef struct {
+gsl_matrix *x_tile;
+gsl_vector *y_tile;
+gsl_vector *z_tile;
+}CrossValidationTile;
+
+static int tile_alloc(CrossValidationTile *tile, size_t number_of_features){
+    tile->x_tile = gsl_matrix_alloc(CROSS_VALIDATION_TILE_ROWS, number_of_features);
+    tile->y_tile = gsl_vector_alloc(CROSS_VALIDATION_TILE_ROWS);
+    tile->z_tile = gsl_vector_alloc(CROSS_VALIDATION_TILE_ROWS);
+    return tile->x_tile && tile->y_tile && tile->z_tile;
+}
+
+static void tile_free(CrossValidationTile *tile){
+    if(tile->x_tile)gsl_matrix_free(tile->x_tile);
+    if(tile->y_tile)gsl_vector_free(tile->y_tile);
+    if(tile->z_tile)gsl_vector_free(tile->z_tile);
+}
+
+/*
+Copies the rows indices[0 .. rows) (rows <= CROSS_VALIDATION_TILE_ROWS) into the tile and points
+the views at the filled part
+ */
+static void tile_gather(CrossValidationRun *run, const size_t *indices, size_t rows, CrossValidationTile *tile, gsl_matrix_view *x_rows, gsl_vector_view *y_rows, gsl_vector_view *z_rows){
+    size_t n = run->x_data->size2;
+    for(size_t r=0;r<rows;r++){
+        gsl_vector_view source = gsl_matrix_row(run->x_data, indices[r]);
+        gsl_vector_view destination = gsl_matrix_row(tile->x_tile, r);
+        gsl_vector_memcpy(&destination.vector, &source.vector);
+        gsl_vector_set(tile->y_tile, r, gsl_vector_get(run->y_data, indices[r]));
+    }
+    *x_rows = gsl_matrix_submatrix(tile->x_tile, 0, 0, rows, n);
+    *y_rows = gsl_vector_subvector(tile->y_tile, 0, rows);
+    *z_rows = gsl_vector_subvector(tile->z_tile, 0, rows);
+}
+
+// MLR first pass: X_f^T X_f and X_f^T y_f of one fold
+static void mlr_fold_task(void *context){
+    CrossValidationTask *task = context;
+    CrossValidationRun *run = task->run;
+    CrossValidationTile tile;
+    if(!tile_alloc(&tile, run->x_data->size2)){
+        tile_free(&tile);
+        task->status = 1; // 1 is for system error
+        return;
+    }
+    gsl_matrix *x_trans_x = run->fold_x_trans_x[task->fold];
+    gsl_vector *x_trans_y = run->fold_x_trans_y[task->fold];
+    size_t end = run->fold_start[task->fold + 1];
+    for(size_t start=run->fold_start[task->fold];start<end;start+=CROSS_VALIDATION_TILE_ROWS){
+        size_t rows = end - start < CROSS_VALIDATION_TILE_ROWS ? end - start : CROSS_VALIDATION_TILE_ROWS;
+        gsl_matrix_view x_rows;
+        gsl_vector_view y_rows, z_rows;
+        tile_gather(run, run->order + start, rows, &tile, &x_rows, &y_rows, &z_rows);
+        gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &x_rows.matrix, 1.0, x_trans_x);
+        gsl_blas_dgemv(CblasTrans, 1.0, &x_rows.matrix, &y_rows.vector, 1.0, x_trans_y);
+    }
+    tile_free(&tile);
+}
+
+// MLR second pass: solve without fold f from the Gram matrices, then score on fold f
+static void mlr_grid_task(void *context){
+    CrossValidationTask *task = context;
+    CrossValidationRun *run = task->run;
+    size_t n = run->x_data->size2, f = task->fold;
+    CrossValidationMetrics *metrics = &run->metrics[task->grid_index*run->number_of_folds + f];
+    double regularisation_param = run->grid[task->grid_index].regularisation_param;
+
+    gsl_matrix *system = gsl_matrix_alloc(n, n);
+    gsl_vector *right_side = gsl_vector_alloc(n);
+    gsl_vector *coeff_set = gsl_vector_alloc(n);
+    CrossValidationTile tile;
+    if(!tile_alloc(&tile, n)||!system||!right_side||!coeff_set){
+        task->status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    // (G - G_f + λI) β = c - c_f, the normal equation of the training rows
+    for(size_t i=0;i<n;i++){
+        for(size_t j=0;j<=i;j++){
+            double value = gsl_matrix_get(run->x_trans_x, i, j) - gsl_matrix_get(run->fold_x_trans_x[f], i, j);
+            gsl_matrix_set(system, i, j, value);
+            gsl_matrix_set(system, j, i, value);
+        }
+        gsl_matrix_set(system, i, i, gsl_matrix_get(system, i, i) + regularisation_param);
+    }
+    gsl_vector_memcpy(right_side, run->x_trans_y);
+    gsl_vector_sub(right_side, run->fold_x_trans_y[f]);
+    if(gsl_linalg_cholesky_decomp(system)!=GSL_SUCCESS||gsl_linalg_cholesky_solve(system, right_side, coeff_set)!=GSL_SUCCESS){
+        metrics->status = 2; // 2 is for arithmatic error
+        goto cleanup;
+    }
+
+    // Squared error and the fold's own spread of y (Welford) for R^2
+    double squared_error = 0, y_mean = 0, y_deviation_sum = 0;
+    size_t start = run->fold_start[f], end = run->fold_start[f + 1], seen = 0;
+    for(;start<end;start+=CROSS_VALIDATION_TILE_ROWS){
+        size_t rows = end - start < CROSS_VALIDATION_TILE_ROWS ? end - start : CROSS_VALIDATION_TILE_ROWS;
+        gsl_matrix_view x_rows;
+        gsl_vector_view y_rows, z_rows;
+        tile_gather(run, run->order + start, rows, &tile, &x_rows, &y_rows, &z_rows);
+        gsl_blas_dgemv(CblasNoTrans, 1.0, &x_rows.matrix, coeff_set, 0.0, &z_rows.vector);
+        for(size_t r=0;r<rows;r++){
+            double y = gsl_vector_get(&y_rows.vector, r);
+            double residual = y - gsl_vector_get(&z_rows.vector, r);
+            squared_error += residual*residual;
+            double delta = y - y_mean;
+            y_mean += delta/(double)(++seen);
+            y_deviation_sum += delta*(y - y_mean);
+        }
+    }
+    metrics->validation_loss = squared_error/seen;
+    metrics->validation_score = y_deviation_sum > 0 ? 1.0 - squared_error/y_deviation_sum : 0.0;
+    metrics->status = 0;
+
+cleanup:
+    tile_free(&tile);
+    if(system)gsl_matrix_free(system);
+    if(right_side)gsl_vector_free(right_side);
+    if(coeff_set)gsl_vector_free(coeff_set);
+}
+
+/*
+Adds X_r^T (σ(X_r w) - y_r) of the rows indices[0 .. count) to gradient
+ */
+static void logistic_gradient_rows(CrossValidationRun *run, const size_t *indices, size_t count, gsl_vector *weight_set, gsl_vector *gradient, CrossValidationTile *tile){
+    for(size_t start=0;start<count;start+=CROSS_VALIDATION_TILE_ROWS){
+        size_t rows = count - start < CROSS_VALIDATION_TILE_ROWS ? count - start : CROSS_VALIDATION_TILE_ROWS;
+        gsl_matrix_view x_rows;
+        gsl_vector_view y_rows, z_rows;
+        tile_gather(run, indices + start, rows, tile, &x_rows, &y_rows, &z_rows);
+        // error = σ(X_r w) - y_r, formed in place while the tile is in cache
+        gsl_blas_dgemv(CblasNoTrans, 1.0, &x_rows.matrix, weight_set, 0.0, &z_rows.vector);
+        sigmoid_vector(z_rows.vector.data, z_rows.vector.data, rows, SIGMOID_EXACT);
+        gsl_vector_sub(&z_rows.vector, &y_rows.vector);
+        gsl_blas_dgemv(CblasTrans, 1.0, &x_rows.matrix, &z_rows.vector, 1.0, gradient);
+    }
+}
+
+// Logistic: gradient descent on every row outside fold f, then score on fold f
+static void logistic_grid_task(void *context){
+    CrossValidationTask *task = context;
+    CrossValidationRun *run = task->run;
+    size_t m = run->x_data->size1, n = run->x_data->size2, f = task->fold;
+    CrossValidationMetrics *metrics = &run->metrics[task->grid_index*run->number_of_folds + f];
+    CrossValidationParameters *parameters = &run->grid[task->grid_index];
+    size_t fold_begin = run->fold_start[f], fold_end = run->fold_start[f + 1];
+    double training_rows = (double)(m - (fold_end - fold_begin));
+
+    gsl_vector *weight_set = gsl_vector_calloc(n);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    CrossValidationTile tile;
+    if(!tile_alloc(&tile, n)||!weight_set||!gradient){
+        task->status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    for(unsigned int i=0;i<parameters->iterations;i++){
+        // The training rows are the two parts of the permutation around the fold
+        gsl_vector_set_zero(gradient);
+        logistic_gradient_rows(run, run->order, fold_begin, weight_set, gradient, &tile);
+        logistic_gradient_rows(run, run->order + fold_end, m - fold_end, weight_set, gradient, &tile);
+        // w := w - learning_rate * (gradient / m_t + λw)
+        gsl_vector_scale(gradient, 1.0/training_rows);
+        gsl_blas_daxpy(parameters->regularisation_param, weight_set, gradient);
+        gsl_blas_daxpy(-parameters->learning_rate, gradient, weight_set);
+    }
+
+    double loss = 0;
+    size_t correct = 0;
+    for(size_t start=fold_begin;start<fold_end;start+=CROSS_VALIDATION_TILE_ROWS){
+        size_t rows = fold_end - start < CROSS_VALIDATION_TILE_ROWS ? fold_end - start : CROSS_VALIDATION_TILE_ROWS;
+        gsl_matrix_view x_rows;
+        gsl_vector_view y_rows, z_rows;
+        tile_gather(run, run->order + start, rows, &tile, &x_rows, &y_rows, &z_rows);
+        gsl_blas_dgemv(CblasNoTrans, 1.0, &x_rows.matrix, weight_set, 0.0, &z_rows.vector);
+        for(size_t r=0;r<rows;r++){
+            double z = gsl_vector_get(&z_rows.vector, r), y = gsl_vector_get(&y_rows.vector, r);
+            loss += softplus(z) - y*z;
+            correct += (z >= 0) == (y >= 0.5);
+        }
+    }
+    metrics->validation_loss = loss/(double)(fold_end - fold_begin);
+    metrics->validation_score = (double)correct/(double)(fold_end - fold_begin);
+    metrics->status = 0;
+
+cleanup:
+    tile_free(&tile);
+    if(weight_set)gsl_vector_free(weight_set);
+    if(gradient)gsl_vector_free(gradient);
+}
+
+void cross_validation_options_default(CrossValidationOptions *options){
+    options->model = CROSS_VALIDATION_MLR;
+    options->number_of_folds = 5;
+    options->shuffle = 1;
+    options->seed = 42;
+}
+
+// Submits one task per entry and waits for all of them; 1 if any could not run
+static unsigned int run_tasks(ThreadPool *pool, thread_pool_task function, CrossValidationTask *tasks, size_t count){
+    ThreadPoolGroup group = {0};
+    unsigned int status = 0;
+    for(size_t t=0;t<count;t++){
+        if(thread_pool_group_submit(pool, &group, function, &tasks[t])!=0){
+            status = 1; // 1 is for system error
+            break;
+        }
+    }
+    // Waits only for this run's tasks, other runs may share the pool
+    thread_pool_group_wait(pool, &group);
+    for(size_t t=0;t<count;t++) if(tasks[t].status) status = 1;
+    return status;
+}
+
+unsigned int cross_validation_run(gsl_matrix *x_data, gsl_vector *y_data, CrossValidationOptions *options, CrossValidationParameters *grid, size_t grid_size, CrossValidationMetrics *metrics, ThreadPool *pool){
+    size_t m = x_data->size1, n = x_data->size2, k = options->number_of_folds;
+    if(y_data->size != m || k < 2 || k > m || grid_size == 0) return 2; // 2 is for arithmatic error
+
+    CrossValidationRun run = {x_data, y_data, grid, metrics, k, NULL, NULL, NULL, NULL, NULL, NULL};
+    CrossValidationTask *tasks = calloc(grid_size*k, sizeof(CrossValidationTask));
+    run.order = malloc(m*sizeof(size_t));
+    run.fold_start = malloc((k + 1)*sizeof(size_t));
+    ThreadPool *own_pool = NULL;
+    unsigned int status = 0;
+    if(!tasks||!run.order||!run.fold_start){
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+    if(!pool){
+        pool = own_pool = thread_pool_create(0);
+        if(!pool){
+            status = 1;
+            goto cleanup;
+        }
+    }
+
+    // Folds are ranges of a (shuffled) permutation of the row indices, sizes differ by at most 1
+    for(size_t i=0;i<m;i++) run.order[i] = i;
+    if(options->shuffle){
+        gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+        if(!rng){
+            status = 1;
+            goto cleanup;
+        }
+        gsl_rng_set(rng, options->seed);
+        gsl_ran_shuffle(rng, run.order, m, sizeof(size_t));
+        gsl_rng_free(rng);
+    }
+    for(size_t f=0;f<=k;f++) run.fold_start[f] = f*m/k;
+
+    for(size_t g=0;g<grid_size;g++){
+        for(size_t f=0;f<k;f++){
+            tasks[g*k + f] = (CrossValidationTask){&run, g, f, 0};
+            CrossValidationMetrics *entry = &metrics[g*k + f];
+            entry->validation_rows = run.fold_start[f + 1] - run.fold_start[f];
+            entry->training_rows = m - entry->validation_rows;
+            entry->validation_loss = NAN;
+            entry->validation_score = NAN;
+            entry->status = 2;
+        }
+    }
+
+    if(options->model == CROSS_VALIDATION_LOGISTIC){
+        status = run_tasks(pool, logistic_grid_task, tasks, grid_size*k);
+        goto cleanup;
+    }
+
+    // MLR: one pass over the data for the per fold Gram matrices, the first k tasks are one per fold
+    run.fold_x_trans_x = calloc(k, sizeof(gsl_matrix *));
+    run.fold_x_trans_y = calloc(k, sizeof(gsl_vector *));
+    run.x_trans_x = gsl_matrix_calloc(n, n);
+    run.x_trans_y = gsl_vector_calloc(n);
+    if(!run.fold_x_trans_x||!run.fold_x_trans_y||!run.x_trans_x||!run.x_trans_y){
+        status = 1;
+        goto cleanup;
+    }
+    for(size_t f=0;f<k;f++){
+        run.fold_x_trans_x[f] = gsl_matrix_calloc(n, n);
+        run.fold_x_trans_y[f] = gsl_vector_calloc(n);
+        if(!run.fold_x_trans_x[f]||!run.fold_x_trans_y[f]){
+            status = 1;
+            goto cleanup;
+        }
+    }
+    status = run_tasks(pool, mlr_fold_task, tasks, k);
+    if(status) goto cleanup;
+    for(size_t f=0;f<k;f++){
+        gsl_matrix_add(run.x_trans_x, run.fold_x_trans_x[f]);
+        gsl_vector_add(run.x_trans_y, run.fold_x_trans_y[f]);
+    }
+    status = run_tasks(pool, mlr_grid_task, tasks, grid_size*k);
+
+cleanup:
+    if(own_pool)thread_pool_destroy(own_pool);
+    if(run.fold_x_trans_x){
+        for(size_t f=0;f<k;f++) if(run.fold_x_trans_x[f])gsl_matrix_free(run.fold_x_trans_x[f]);
+        free(run.fold_x_trans_x);
+    }
+    if(run.fold_x_trans_y){
+        for(size_t f=0;f<k;f++) if(run.fold_x_trans_y[f])gsl_vector_free(run.fold_x_trans_y[f]);
+        free(run.fold_x_trans_y);
+    }
+    if(run.x_trans_x)gsl_matrix_free(run.x_trans_x);
+    if(run.x_trans_y)gsl_vector_free(run.x_trans_y);
+    free(run.order);
+    free(run.fold_start);
+    free(tasks);
+    return status;
+}
+
+size_t cross_validation_best(CrossValidationMetrics *metrics, size_t grid_size, size_t number_of_folds){
+    size_t best = grid_size;
+    double best_loss = 0;
+    for(size_t g=0;g<grid_size;g++){
+        double loss = 0;
+        int failed = 0;
+        for(size_t f=0;f<number_of_folds;f++){
+            CrossValidationMetrics *entry = &metrics[g*number_of_folds + f];
+            if(entry->status){
+                failed = 1;
+                break;
+            }
+            loss += entry->validation_loss;
+        }
+        loss /= number_of_folds;
+        if(!failed && (best == grid_size || loss < best_loss)){
+            best = g;
+            best_loss = loss;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,135 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CROSS_VALIDATION_H
+#define CROSS_VALIDATION_H
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include "thread_pool.h"
+
+typedef enum {
+CROSS_VALIDATION_MLR = 0,       // ridge regression as `mlr_train`
+CROSS_VALIDATION_LOGISTIC = 1   // gradient descent as `logistic_regression_train`
+}CrossValidationModel;
+
+/*
+ * Settings of `cross_validation_run`, fill with `cross_validation_options_default` and change 
+ * what is needed.
+ */
+typedef struct {
+CrossValidationModel model;
+size_t number_of_folds;         // k, at least 2 and at most the number of rows
+int shuffle;                    // 1 assigns the rows to folds in a random order, 0 cuts the rows in order
+unsigned long seed;             // seed of the shuffle, equal seeds give equal folds
+}CrossValidationOptions;
+
+/*
+ * One point of the parameter grid. Every model only reads its own fields.
+ */
+typedef struct {
+double regularisation_param;    // MLR: λ of X^T X + λI; logistic: λ of the (λ/2)*||w||^2 penalty
+double learning_rate;           // logistic only
+unsigned int iterations;        // logistic only
+}CrossValidationParameters;
+
+/*
+ * Result of one grid point on one fold: the model trained on the other k - 1 folds, scored on 
+ * this one.
+ */
+typedef struct {
+size_t training_rows;
+size_t validation_rows;
+double validation_loss;         // MLR: mean squared error; logistic: mean cross entropy
+double validation_score;        // MLR: R^2; logistic: share of rows classified correctly at 0.5
+unsigned int status;            // 0, or 2 if training failed (X^T X + λI not positive definite)
+}CrossValidationMetrics;
+
+
+/*
+ * Function: cross_validation_options_default
+ * ----------------------------
+ */
+void cross_validation_options_default(CrossValidationOptions *options);
+/*
+ * Fills `options` with the defaults: multiple linear regression, 5 folds, shuffled with seed 42.
+ */
+
+
+/*
+ * Function: cross_validation_run
+ * ----------------------------
+ */
+unsigned int cross_validation_run(gsl_matrix *x_data, gsl_vector *y_data, CrossValidationOptions *options, CrossValidationParameters *grid, size_t grid_size, CrossValidationMetrics *metrics, ThreadPool *pool);
+/*
+ * Runs k-fold cross-validation of every point of `grid`: for each fold f and grid point g the 
+ * model is trained on all rows outside fold f and scored on the rows of fold f. All (g, f) pairs 
+ * are independent tasks and run concurrently on `pool`.
+ *
+ * The data is never copied. A fold is a range of a permutation of the row indices (m indices 
+ * in total), and the tasks read the rows they need through those indices, a tile of 256 rows 
+ * at a time gathered into a small per task buffer that stays in cache. Memory is therefore one 
+ * copy of the data (the caller's) plus O(m + k * n^2 + threads * 256 * n) whatever the grid.
+ *
+ * CROSS_VALIDATION_MLR: since X^T X and X^T y are sums over rows, one pass over the data (one 
+ * task per fold) forms every fold's G_f = X_f^T X_f and c_f = X_f^T y_f and their totals G, c. 
+ * Training without fold f is then
+ *    (G - G_f + λI) β = c - c_f
+ * an O(n^3) Cholesky solve that reads no data, so the grid costs almost nothing beyond the 
+ * single pass plus one pass over the fold to score it. β equals `mlr_train` on the training rows 
+ * up to rounding.
+ *
+ * CROSS_VALIDATION_LOGISTIC: every task runs `iterations` steps of full batch gradient descent 
+ * from w = 0 on the training rows,
+ *    w := w - learning_rate * ((1/m_t) * X_t^T (σ(X_t w) - y_t) + λ w)
+ * which with λ = 0 is the update of `logistic_regression_train`.
+ *
+ * Arguments:
+ *    - x_data: A `gsl_matrix` (m x n) of features (e.g. a mapped `Dataset`).
+ *    - y_data: A `gsl_vector` of the m targets (0 or 1 for the logistic model).
+ *    - options: The model, number of folds and shuffling.
+ *    - grid: An array of `grid_size` parameter sets.
+ *    - grid_size: The number of grid points (at least 1).
+ *    - metrics: An array of grid_size * k entries receiving the results, grid point g and fold f 
+ *      in metrics[g * k + f].
+ *    - pool: The pool to run on, or NULL to start one with a thread per CPU for this call.
+ *
+ * Returns:
+ *    - `0` if every task ran (a task may still report status 2 in its metrics).
+ *    - `1` if there was a system error (e.g., memory allocation or thread creation failure).
+ *    - `2` if a dimension does not match, k is out of range or the grid is empty.
+ *
+ * Notes:
+ *    - The pool may be shared: several runs can use it at the same time, from different threads 
+ *      or from inside tasks of the same pool, and each run waits only for its own tasks.
+ */
+
+
+/*
+ * Function: cross_validation_best
+ * ----------------------------
+ */
+size_t cross_validation_best(CrossValidationMetrics *metrics, size_t grid_size, size_t number_of_folds);
+/*
+ * Returns the index of the grid point with the lowest validation loss averaged over the folds. 
+ * Grid points where a fold failed (status 2) are skipped; if all failed, grid_size is returned.
+ */
+
+#endif // CROSS_VALIDATION_H
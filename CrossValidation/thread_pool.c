@@ -0,0 +1,186 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+typedef struct {
+thread_pool_task task;
+void *task_context;
+ThreadPoolGroup *group;         // NULL for tasks submitted without a group
+}ThreadPoolEntry;
+
+struct ThreadPool {
+pthread_t *threads;
+unsigned int number_of_threads;
+pthread_mutex_t lock;
+pthread_cond_t work_available;  // signalled when a task is queued or the pool stops
+pthread_cond_t work_done;       // broadcast when the queue is empty and no task runs, or a group finishes
+ThreadPoolEntry *queue;         // ring of capacity entries, count of them from head on
+size_t capacity;
+size_t head;
+size_t count;
+size_t running;                 // tasks taken from the queue and not finished yet
+int stopping;
+};
+
+// Bookkeeping after a task taken from the queue has run, called with the lock held
+static void thread_pool_finish(ThreadPool *pool, ThreadPoolGroup *group){
+    pool->running--;
+    int group_done = group && --group->pending == 0;
+    if(group_done || (pool->count == 0 && pool->running == 0)) pthread_cond_broadcast(&pool->work_done);
+}
+
+static void *thread_pool_worker(void *argument){
+    ThreadPool *pool = argument;
+    pthread_mutex_lock(&pool->lock);
+    for(;;){
+        while(pool->count == 0 && !pool->stopping) pthread_cond_wait(&pool->work_available, &pool->lock);
+        if(pool->count == 0) break; // stopping and nothing left to run
+        ThreadPoolEntry entry = pool->queue[pool->head];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+        pool->running++;
+        pthread_mutex_unlock(&pool->lock);
+
+        entry.task(entry.task_context);
+
+        pthread_mutex_lock(&pool->lock);
+        thread_pool_finish(pool, entry.group);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ThreadPool *thread_pool_create(unsigned int number_of_threads){
+    if(number_of_threads == 0){
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        number_of_threads = cpus > 0 ? (unsigned int)cpus : 1;
+    }
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if(!pool)return NULL;
+    pool->threads = calloc(number_of_threads, sizeof(pthread_t));
+    pool->capacity = 64;
+    pool->queue = malloc(pool->capacity*sizeof(ThreadPoolEntry));
+    if(!pool->threads||!pool->queue){
+        free(pool->threads);
+        free(pool->queue);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_available, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    for(unsigned int t=0;t<number_of_threads;t++){
+        if(pthread_create(&pool->threads[t], NULL, thread_pool_worker, pool) != 0){
+            // Stop the workers that did start
+            pool->number_of_threads = t;
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+    pool->number_of_threads = number_of_threads;
+    return pool;
+}
+
+unsigned int thread_pool_size(ThreadPool *pool){
+    return pool->number_of_threads;
+}
+
+unsigned int thread_pool_submit(ThreadPool *pool, thread_pool_task task, void *task_context){
+    return thread_pool_group_submit(pool, NULL, task, task_context);
+}
+
+unsigned int thread_pool_group_submit(ThreadPool *pool, ThreadPoolGroup *group, thread_pool_task task, void *task_context){
+    pthread_mutex_lock(&pool->lock);
+    if(pool->count == pool->capacity){
+        // Double the ring and unwrap it so the entries start at 0 again
+        ThreadPoolEntry *queue = malloc(2*pool->capacity*sizeof(ThreadPoolEntry));
+        if(!queue){
+            pthread_mutex_unlock(&pool->lock);
+            return 1; // 1 is for system error
+        }
+        size_t first = pool->capacity - pool->head;
+        memcpy(queue, pool->queue + pool->head, first*sizeof(ThreadPoolEntry));
+        memcpy(queue + first, pool->queue, pool->head*sizeof(ThreadPoolEntry));
+        free(pool->queue);
+        pool->queue = queue;
+        pool->head = 0;
+        pool->capacity *= 2;
+    }
+    pool->queue[(pool->head + pool->count) % pool->capacity] = (ThreadPoolEntry){task, task_context, group};
+    pool->count++;
+    if(group) group->pending++;
+    pthread_cond_signal(&pool->work_available);
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+void thread_pool_group_wait(ThreadPool *pool, ThreadPoolGroup *group){
+    pthread_mutex_lock(&pool->lock);
+    while(group->pending > 0){
+        // Run the oldest queued task of the group here instead of waiting for a worker
+        size_t k = 0;
+        while(k < pool->count && pool->queue[(pool->head + k) % pool->capacity].group != group) k++;
+        if(k == pool->count){
+            // All remaining tasks of the group are running on other threads
+            pthread_cond_wait(&pool->work_done, &pool->lock);
+            continue;
+        }
+        ThreadPoolEntry entry = pool->queue[(pool->head + k) % pool->capacity];
+        // Close the gap by moving the k entries before it one place back
+        for(; k > 0; k--) pool->queue[(pool->head + k) % pool->capacity] = pool->queue[(pool->head + k - 1) % pool->capacity];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+        pool->running++;
+        pthread_mutex_unlock(&pool->lock);
+
+        entry.task(entry.task_context);
+
+        pthread_mutex_lock(&pool->lock);
+        thread_pool_finish(pool, group);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void thread_pool_wait(ThreadPool *pool){
+    pthread_mutex_lock(&pool->lock);
+    while(pool->count > 0 || pool->running > 0) pthread_cond_wait(&pool->work_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void thread_pool_destroy(ThreadPool *pool){
+    if(!pool)return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->work_available);
+    pthread_mutex_unlock(&pool->lock);
+    for(unsigned int t=0;t<pool->number_of_threads;t++) pthread_join(pool->threads[t], NULL);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_available);
+    pthread_cond_destroy(&pool->work_done);
+    free(pool->threads);
+    free(pool->queue);
+    free(pool);
+}
@@ -0,0 +1,141 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+
+/*
+ * A fixed set of worker threads that run submitted tasks in the order they were submitted. It is 
+ * created once and can be shared by many jobs run one after the other (e.g. the folds and grid 
+ * points of several cross-validations), so no thread is started per task. The struct is internal 
+ * to thread_pool.c.
+ */
+typedef struct ThreadPool ThreadPool;
+
+// A task: called once on one of the worker threads with the context given to `thread_pool_submit`
+typedef void (*thread_pool_task)(void *task_context);
+
+/*
+ * The tasks of one job (e.g. one cross-validation run), so that the job can wait for its own 
+ * tasks while other jobs use the same pool. Owned by the caller (usually a local variable), 
+ * zero initialise it before the first `thread_pool_group_submit`; the pool updates it under its 
+ * lock.
+ */
+typedef struct {
+size_t pending;     // tasks submitted with the group that have not finished
+}ThreadPoolGroup;
+
+
+/*
+ * Function: thread_pool_create
+ * ----------------------------
+ */
+ThreadPool *thread_pool_create(unsigned int number_of_threads);
+/*
+ * Starts a pool of worker threads that wait for tasks.
+ *
+ * Arguments:
+ *    - number_of_threads: The number of workers, 0 for the number of online CPUs.
+ *
+ * Returns:
+ *    - A pointer to the pool, to be released with `thread_pool_destroy`.
+ *    - `NULL` if an allocation or thread creation failed.
+ */
+
+
+/*
+ * Function: thread_pool_size
+ * ----------------------------
+ */
+unsigned int thread_pool_size(ThreadPool *pool);
+/*
+ * Returns the number of worker threads of the pool.
+ */
+
+
+/*
+ * Function: thread_pool_submit
+ * ----------------------------
+ */
+unsigned int thread_pool_submit(ThreadPool *pool, thread_pool_task task, void *task_context);
+/*
+ * Queues `task(task_context)` to run on the next free worker. The queue grows as needed, so 
+ * submitting never blocks on running tasks.
+ *
+ * Returns:
+ *    - `0` if the task was queued.
+ *    - `1` if there was a system error (the queue could not grow).
+ */
+
+
+/*
+ * Function: thread_pool_group_submit
+ * ----------------------------
+ */
+unsigned int thread_pool_group_submit(ThreadPool *pool, ThreadPoolGroup *group, thread_pool_task task, void *task_context);
+/*
+ * Same as `thread_pool_submit`, and counts the task in `group` until it has finished, so 
+ * `thread_pool_group_wait` can wait for it. The group must stay valid until then.
+ *
+ * Returns:
+ *    - `0` if the task was queued.
+ *    - `1` if there was a system error (the queue could not grow), the group is unchanged.
+ */
+
+
+/*
+ * Function: thread_pool_group_wait
+ * ----------------------------
+ */
+void thread_pool_group_wait(ThreadPool *pool, ThreadPoolGroup *group);
+/*
+ * Blocks until every task submitted with `group` has finished; tasks of other groups are not 
+ * waited for. While tasks of the group are still queued the caller takes them off the queue 
+ * and runs them itself, so a task may start a job on its own pool and wait for it without 
+ * deadlocking, even when every worker is busy.
+ */
+
+
+/*
+ * Function: thread_pool_wait
+ * ----------------------------
+ */
+void thread_pool_wait(ThreadPool *pool);
+/*
+ * Blocks until the queue is empty and no task is running, i.e. every task submitted so far by 
+ * anyone has finished. On a shared pool use `thread_pool_group_wait` instead: this function 
+ * also waits for unrelated jobs, and it must never be called from inside a task of the same 
+ * pool, since the calling task itself keeps the pool busy and the wait would never end.
+ */
+
+
+/*
+ * Function: thread_pool_destroy
+ * ----------------------------
+ */
+void thread_pool_destroy(ThreadPool *pool);
+/*
+ * Runs the tasks still queued, stops and joins the workers and frees the pool. Passing `NULL` 
+ * does nothing.
+ */
+
+#endif // THREAD_POOL_H
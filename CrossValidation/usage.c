@@ -0,0 +1,98 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "cross_validation.h"
+
+#define ROWS 2000
+#define FEATURES 6
+#define FOLDS 5
+
+int main() {
+    // Synthetic data: a bias column, y = 1 + Σ x_j + noise, and a class label from the same sum
+    gsl_matrix *x_data = gsl_matrix_alloc(ROWS, FEATURES);
+    gsl_vector *y_data = gsl_vector_alloc(ROWS);
+    gsl_vector *labels = gsl_vector_alloc(ROWS);
+    srand(7);
+    for (size_t i = 0; i < ROWS; i++) {
+        double sum = 1.0;
+        gsl_matrix_set(x_data, i, 0, 1.0);
+        for (size_t j = 1; j < FEATURES; j++) {
+            double value = 2.0 * rand() / RAND_MAX - 1.0;
+            gsl_matrix_set(x_data, i, j, value);
+            sum += value;
+        }
+        double noise = (double)rand() / RAND_MAX - 0.5;
+        gsl_vector_set(y_data, i, sum + noise);
+        gsl_vector_set(labels, i, sum + noise > 1.0 ? 1.0 : 0.0);
+    }
+
+    // One pool for both searches
+    ThreadPool *pool = thread_pool_create(0);
+    if (!pool) {
+        printf("Could not start the thread pool\n");
+        return 1;
+    }
+
+    // Ridge λ for multiple linear regression
+    CrossValidationParameters ridge_grid[4] = {{0.0, 0, 0}, {1.0, 0, 0}, {100.0, 0, 0}, {10000.0, 0, 0}};
+    CrossValidationMetrics ridge_metrics[4 * FOLDS];
+    CrossValidationOptions options;
+    cross_validation_options_default(&options);
+    options.number_of_folds = FOLDS;
+    unsigned int result = cross_validation_run(x_data, y_data, &options, ridge_grid, 4, ridge_metrics, pool);
+    if (result != 0) {
+        printf("Cross-validation failed with error code: %u\n", result);
+        return 1;
+    }
+    printf("Multiple linear regression, %d folds:\n", FOLDS);
+    for (size_t g = 0; g < 4; g++) {
+        printf("lambda %8.1f:", ridge_grid[g].regularisation_param);
+        for (size_t f = 0; f < FOLDS; f++) printf(" MSE %.4f", ridge_metrics[g * FOLDS + f].validation_loss);
+        printf("\n");
+    }
+    printf("Best lambda: %.1f\n", ridge_grid[cross_validation_best(ridge_metrics, 4, FOLDS)].regularisation_param);
+
+    // Learning rate and iterations for logistic regression on the same data
+    CrossValidationParameters logistic_grid[3] = {{0.0, 0.1, 100}, {0.0, 1.0, 100}, {0.0, 1.0, 500}};
+    CrossValidationMetrics logistic_metrics[3 * FOLDS];
+    options.model = CROSS_VALIDATION_LOGISTIC;
+    result = cross_validation_run(x_data, labels, &options, logistic_grid, 3, logistic_metrics, pool);
+    if (result != 0) {
+        printf("Cross-validation failed with error code: %u\n", result);
+        return 1;
+    }
+    printf("\nLogistic regression, %d folds:\n", FOLDS);
+    for (size_t g = 0; g < 3; g++) {
+        printf("rate %.1f, %3u iterations:", logistic_grid[g].learning_rate, logistic_grid[g].iterations);
+        for (size_t f = 0; f < FOLDS; f++) printf(" %.3f", logistic_metrics[g * FOLDS + f].validation_score);
+        printf(" (accuracy per fold)\n");
+    }
+
+    thread_pool_destroy(pool);
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(labels);
+    return 0;
+}
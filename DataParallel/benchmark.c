@@ -0,0 +1,209 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Scaling of the data parallel entry points with the number of worker processes.
+ * Usage: ./benchmark [-j] [-q] [-r repetitions]
+ *    -j  print the results as JSON, for tracking regressions between versions
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case, the median is reported (default 5)
+ * Every entry point runs with 1, 2, 4, ... worker processes up to the number of CPUs, on the 
+ * data of MultipleLinearRegression/benchmark.c at 10^5 to 10^6 rows and 8 or 64 features. The 
+ * single process function (mlr_train, ...) is measured first as the baseline. The times include 
+ * forking the workers and creating the shared segment. See Benchmark/README.md for how the rates 
+ * are defined.
+ * A case is only reported if every call returned 0 and the coefficients match the baseline's to 
+ * 1e-10 relative to the largest of them; otherwise the benchmark stops with exit status 1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "data_parallel.h"
+#include "../MultipleLinearRegression/multiple_linear_regression.h"
+#include "../LogisticRegression/logistic_regression.h"
+#include "../Benchmark/benchmark_report.h"
+
+// Iterations per gradient descent call
+#define BENCHMARK_ITERATIONS 10
+// Largest rows x features generated
+#define BENCHMARK_MAX_VALUES (1u<<26)
+// Largest accepted difference to the baseline coefficients, relative to the largest of them
+#define BENCHMARK_TOLERANCE 1e-10
+
+typedef struct {
+gsl_matrix *x_data;
+gsl_vector *y_data;
+gsl_vector *labels;         // y > 1 as 0/1, for logistic regression
+gsl_vector *coeff_set;
+gsl_vector *baseline_set;   // coefficients of the single process function
+unsigned int number_of_workers;
+unsigned int status;        // last non zero return code of the timed calls, 0 if all succeeded
+}DataParallelCase;
+
+static void record_status(DataParallelCase *c, unsigned int status){
+    if(status) c->status = status;
+}
+
+static void run_mlr_train(void *context){
+    DataParallelCase *c = context;
+    record_status(c, mlr_train(c->x_data, c->y_data, c->coeff_set, 1e-9));
+}
+
+static void run_data_parallel_mlr_train(void *context){
+    DataParallelCase *c = context;
+    record_status(c, data_parallel_mlr_train(c->x_data, c->y_data, c->coeff_set, 1e-9, c->number_of_workers));
+}
+
+static void run_gradient_descent(void *context){
+    DataParallelCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    record_status(c, refine_mlr_gradient_descent(c->x_data, c->y_data, c->coeff_set, BENCHMARK_ITERATIONS, 0.5));
+}
+
+static void run_data_parallel_gradient_descent(void *context){
+    DataParallelCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    record_status(c, data_parallel_refine_mlr_gradient_descent(c->x_data, c->y_data, c->coeff_set, BENCHMARK_ITERATIONS, 0.5, c->number_of_workers));
+}
+
+static void run_logistic(void *context){
+    DataParallelCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    record_status(c, logistic_regression_train(c->labels, c->x_data, c->coeff_set, 0.5, BENCHMARK_ITERATIONS));
+}
+
+static void run_data_parallel_logistic(void *context){
+    DataParallelCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    record_status(c, data_parallel_logistic_regression_train(c->labels, c->x_data, c->coeff_set, 0.5, BENCHMARK_ITERATIONS, c->number_of_workers));
+}
+
+// Largest difference of coeff_set to baseline_set, relative to the largest baseline coefficient
+static double baseline_difference(DataParallelCase *c){
+    double difference = 0, largest = 0;
+    for(size_t j=0;j<c->coeff_set->size;j++){
+        double expected = gsl_vector_get(c->baseline_set, j);
+        difference = fmax(difference, fabs(gsl_vector_get(c->coeff_set, j) - expected));
+        largest = fmax(largest, fabs(expected));
+    }
+    return largest > 0 ? difference/largest : difference;
+}
+
+/*
+Times the single process baseline, then the data parallel version at every worker count. Returns 1 
+without reporting the case if a call failed or the coefficients differ from the baseline's
+ */
+static unsigned int measure(BenchmarkReport *report, DataParallelCase *c, BenchmarkResult *result, const char *name, benchmark_function baseline, benchmark_function data_parallel, unsigned int max_workers){
+    char function[64];
+    result->function = name;
+    c->status = 0;
+    result->seconds = benchmark_time(baseline, c, report->repetitions);
+    if(c->status != 0){
+        fprintf(stderr, "%s failed with status %u (%zu x %zu)\n", name, c->status, result->rows, result->features);
+        return 1;
+    }
+    gsl_vector_memcpy(c->baseline_set, c->coeff_set);
+    benchmark_print(report, result);
+    for(c->number_of_workers=1;c->number_of_workers<=max_workers;c->number_of_workers*=2){
+        snprintf(function, sizeof(function), "data_parallel_%s (%u workers)", name, c->number_of_workers);
+        result->function = function;
+        c->status = 0;
+        result->seconds = benchmark_time(data_parallel, c, report->repetitions);
+        if(c->status != 0){
+            fprintf(stderr, "%s failed with status %u (%zu x %zu)\n", function, c->status, result->rows, result->features);
+            return 1;
+        }
+        double difference = baseline_difference(c);
+        if(!(difference <= BENCHMARK_TOLERANCE)){
+            fprintf(stderr, "%s differs from %s by %.3e (%zu x %zu)\n", function, name, difference, result->rows, result->features);
+            return 1;
+        }
+        benchmark_print(report, result);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv){
+    BenchmarkReport report;
+    if(benchmark_parse_arguments(&report, "data_parallel", argc, argv) != 0) return 1;
+    size_t row_sizes[] = {100000, 1000000};
+    size_t feature_sizes[] = {8, 64};
+    size_t number_of_row_sizes = report.quick ? 1 : 2;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_workers = cpus > 1 ? (unsigned int)cpus : 1;
+
+    benchmark_begin(&report);
+    for(size_t r=0;r<number_of_row_sizes;r++){
+        for(size_t f=0;f<2;f++){
+            size_t rows = row_sizes[r], features = feature_sizes[f];
+            if(rows*features > BENCHMARK_MAX_VALUES) continue;
+            DataParallelCase c;
+            c.x_data = gsl_matrix_alloc(rows, features);
+            c.y_data = gsl_vector_alloc(rows);
+            c.labels = gsl_vector_alloc(rows);
+            c.coeff_set = gsl_vector_calloc(features);
+            c.baseline_set = gsl_vector_alloc(features);
+            if(!c.x_data||!c.y_data||!c.labels||!c.coeff_set||!c.baseline_set){
+                fprintf(stderr, "Could not allocate %zu x %zu data\n", rows, features);
+                return 1;
+            }
+            srand(42);
+            for(size_t i=0;i<rows;i++){
+                double y = 1.0;
+                gsl_matrix_set(c.x_data, i, 0, 1.0);
+                for(size_t j=1;j<features;j++){
+                    double value = 2.0*((double)rand()/RAND_MAX - 0.5);
+                    gsl_matrix_set(c.x_data, i, j, value);
+                    y += value*j/features;
+                }
+                y += 0.01*((double)rand()/RAND_MAX - 0.5);
+                gsl_vector_set(c.y_data, i, y);
+                gsl_vector_set(c.labels, i, y > 1.0 ? 1.0 : 0.0);
+            }
+            double m = rows, n = features;
+
+            // Normal equation: X^T X (2mn^2), X^T y (2mn), Cholesky and solve (about n^3)
+            BenchmarkResult result = {"mlr_train", rows, features, 1, 0, 2*m*n*n + 2*m*n + n*n*n, 8*m*n + 8*m};
+            unsigned int failed = measure(&report, &c, &result, "mlr_train", run_mlr_train, run_data_parallel_mlr_train, max_workers);
+
+            // Every iteration: X*beta and X^T*error (4mn); X is read twice
+            result.passes = BENCHMARK_ITERATIONS;
+            result.flops = BENCHMARK_ITERATIONS*(4*m*n + m + 2*n);
+            result.bytes = BENCHMARK_ITERATIONS*(16*m*n + 32*m);
+            if(!failed) failed = measure(&report, &c, &result, "refine_mlr_gradient_descent", run_gradient_descent, run_data_parallel_gradient_descent, max_workers);
+
+            // Every iteration: X*w and X^T*error (4mn), sigmoid (about 20m)
+            result.flops = BENCHMARK_ITERATIONS*(4*m*n + 20*m + 2*n);
+            if(!failed) failed = measure(&report, &c, &result, "logistic_regression_train", run_logistic, run_data_parallel_logistic, max_workers);
+
+            gsl_matrix_free(c.x_data);
+            gsl_vector_free(c.y_data);
+            gsl_vector_free(c.labels);
+            gsl_vector_free(c.coeff_set);
+            gsl_vector_free(c.baseline_set);
+            if(failed) return 1;
+        }
+    }
+    benchmark_end(&report);
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "data_parallel.h"
+#include "../LogisticRegression/logistic_regression.h"
+
+typedef enum {
+DATA_PARALLEL_MLR_TRAIN,
+DATA_PARALLEL_MLR_GRADIENT_DESCENT,
+DATA_PARALLEL_LOGISTIC
+}DataParallelJob;
+
+// What the workers compute, filled by the caller's process before the fork
+typedef struct {
+DataParallelJob job;
+gsl_matrix *x_data;
+gsl_vector *y_data;
+double regularisation_param;
+double learning_rate;
+unsigned int iterations;
+}DataParallelTask;
+
+/*
+Start of the shared segment. It is followed (at a multiple of 64 bytes) by the slots
+(number_of_workers x length doubles), the reduced result (length) and the coefficients (n)
+ */
+typedef struct {
+pthread_barrier_t barrier;      // process shared, number_of_workers parties
+unsigned int number_of_workers;
+size_t length;                  // doubles per partial sum
+int failed;                     // set by a worker that could not allocate its scratch
+unsigned int status;            // return code decided by worker 0
+}DataParallelShared;
+
+// One worker's view of the segment
+typedef struct {
+DataParallelShared *shared;
+double *slots;
+double *result;
+double *coefficients;
+unsigned int rank;
+}DataParallelWorker;
+
+#define DATA_PARALLEL_HEADER_BYTES ((sizeof(DataParallelShared) + 63) / 64 * 64)
+
+/*
+Every worker reports whether it allocated its scratch; returns 0 in all workers if any failed,
+so that none of them is left waiting at a barrier
+ */
+static int worker_ready(DataParallelWorker *worker, int allocated){
+    if(!allocated) __atomic_store_n(&worker->shared->failed, 1, __ATOMIC_RELAXED);
+    pthread_barrier_wait(&worker->shared->barrier);
+    return !__atomic_load_n(&worker->shared->failed, __ATOMIC_RELAXED);
+}
+
+/*
+total = Σ over workers of partial (length doubles each), the same in every worker.
+Worker r adds up part r of the slots in rank order, so the sum does not depend on timing
+ */
+static void allreduce(DataParallelWorker *worker, const double *partial, double *total){
+    DataParallelShared *shared = worker->shared;
+    size_t length = shared->length, workers = shared->number_of_workers;
+    memcpy(worker->slots + worker->rank*length, partial, length*sizeof(double));
+    pthread_barrier_wait(&shared->barrier);
+
+    size_t begin = worker->rank*length/workers, end = (worker->rank + 1)*length/workers;
+    for(size_t i=begin;i<end;i++){
+        double sum = 0;
+        for(size_t r=0;r<workers;r++) sum += worker->slots[r*length + i];
+        worker->result[i] = sum;
+    }
+    // The next allreduce only writes the slots after everyone passed its first barrier, i.e. read the result
+    pthread_barrier_wait(&shared->barrier);
+    memcpy(total, worker->result, length*sizeof(double));
+}
+
+// Rows of the worker's shard
+static gsl_matrix_view shard_rows(DataParallelWorker *worker, gsl_matrix *x_data, size_t *begin, size_t *rows){
+    size_t m = x_data->size1, workers = worker->shared->number_of_workers;
+    *begin = worker->rank*m/workers;
+    *rows = (worker->rank + 1)*m/workers - *begin;
+    return gsl_matrix_submatrix(x_data, *begin, 0, *rows, x_data->size2);
+}
+
+static unsigned int worker_mlr_train(DataParallelWorker *worker, DataParallelTask *task){
+    size_t n = task->x_data->size2, begin, rows;
+    gsl_matrix_view x_shard = shard_rows(worker, task->x_data, &begin, &rows);
+    gsl_vector_view y_shard = gsl_vector_subvector(task->y_data, begin, rows);
+    // Partial sums packed as [X^T X (n x n) | X^T Y (n)]
+    double *partial = calloc(n*n + n, sizeof(double));
+    double *total = malloc((n*n + n)*sizeof(double));
+    if(!worker_ready(worker, partial && total)){
+        free(partial);
+        free(total);
+        return 1; // 1 is for system error
+    }
+
+    gsl_matrix_view x_trans_x = gsl_matrix_view_array(partial, n, n);
+    gsl_vector_view x_trans_y = gsl_vector_view_array(partial + n*n, n);
+    gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &x_shard.matrix, 0.0, &x_trans_x.matrix);
+    gsl_blas_dgemv(CblasTrans, 1.0, &x_shard.matrix, &y_shard.vector, 0.0, &x_trans_y.vector);
+    allreduce(worker, partial, total);
+
+    if(worker->rank == 0){
+        gsl_matrix_view system = gsl_matrix_view_array(total, n, n);
+        gsl_vector_view right_side = gsl_vector_view_array(total + n*n, n);
+        gsl_vector_view coeff_set = gsl_vector_view_array(worker->coefficients, n);
+        // Mirror the lower triangle and add the ridge term on the diagonal
+        for(size_t i=0;i<n;i++){
+            for(size_t j=0;j<i;j++) gsl_matrix_set(&system.matrix, j, i, gsl_matrix_get(&system.matrix, i, j));
+            gsl_matrix_set(&system.matrix, i, i, gsl_matrix_get(&system.matrix, i, i) + task->regularisation_param);
+        }
+        if(gsl_linalg_cholesky_decomp(&system.matrix)!=GSL_SUCCESS||gsl_linalg_cholesky_solve(&system.matrix, &right_side.vector, &coeff_set.vector)!=GSL_SUCCESS){
+            worker->shared->status = 2; // 2 is for arithmatic error
+        }
+    }
+    free(partial);
+    free(total);
+    return 0;
+}
+
+// Gradient descent for both models, which only differ in the link applied to X_r w
+static unsigned int worker_gradient_descent(DataParallelWorker *worker, DataParallelTask *task){
+    size_t m = task->x_data->size1, n = task->x_data->size2, begin, rows;
+    gsl_matrix_view x_shard = shard_rows(worker, task->x_data, &begin, &rows);
+    gsl_vector_view y_shard = gsl_vector_subvector(task->y_data, begin, rows);
+    gsl_vector_view coeff_set = gsl_vector_view_array(worker->coefficients, n);
+    gsl_vector *weights = gsl_vector_alloc(n);
+    gsl_vector *partial = gsl_vector_alloc(n);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *error_set = gsl_vector_alloc(rows);
+    int allocated = weights && partial && gradient && error_set;
+    if(worker_ready(worker, allocated)){
+        // Every worker starts from the caller's coefficients and applies the same updates
+        gsl_vector_memcpy(weights, &coeff_set.vector);
+        for(unsigned int i=0;i<task->iterations;i++){
+            // error_set = link(X_r w) - Y_r
+            gsl_blas_dgemv(CblasNoTrans, 1.0, &x_shard.matrix, weights, 0.0, error_set);
+            if(task->job == DATA_PARALLEL_LOGISTIC) sigmoid_vector(error_set->data, error_set->data, rows, SIGMOID_EXACT);
+            gsl_vector_sub(error_set, &y_shard.vector);
+            gsl_blas_dgemv(CblasTrans, 1.0, &x_shard.matrix, error_set, 0.0, partial);
+            allreduce(worker, partial->data, gradient->data);
+
+            // The same scaling as the single process functions, so the rounding matches too
+            if(task->job == DATA_PARALLEL_LOGISTIC){
+                gsl_vector_scale(gradient, task->learning_rate/m);
+                gsl_vector_sub(weights, gradient);
+            }
+            else{
+                gsl_vector_scale(gradient, 1.0/m);
+                gsl_blas_daxpy(-task->learning_rate, gradient, weights);
+            }
+        }
+        // All workers hold the same weights, worker 0 hands them back
+        if(worker->rank == 0) gsl_vector_memcpy(&coeff_set.vector, weights);
+    }
+    if(weights)gsl_vector_free(weights);
+    if(partial)gsl_vector_free(partial);
+    if(gradient)gsl_vector_free(gradient);
+    if(error_set)gsl_vector_free(error_set);
+    return allocated ? 0 : 1; // 1 is for system error
+}
+
+/*
+Forks the workers, waits for all of them and copies the coefficients back into coeff_set.
+length is the number of doubles reduced per allreduce
+ */
+static unsigned int data_parallel_run(DataParallelTask *task, gsl_vector *coeff_set, unsigned int number_of_workers, size_t length){
+    size_t m = task->x_data->size1, n = task->x_data->size2;
+    if(number_of_workers == 0){
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        number_of_workers = cpus > 0 ? (unsigned int)cpus : 1;
+    }
+    if(number_of_workers > m) number_of_workers = (unsigned int)m;
+
+    size_t segment_bytes = DATA_PARALLEL_HEADER_BYTES + ((size_t)number_of_workers*length + length + n)*sizeof(double);
+    void *segment = mmap(NULL, segment_bytes, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+    if(segment == MAP_FAILED) return 1; // 1 is for system error
+    DataParallelShared *shared = segment;
+    shared->number_of_workers = number_of_workers;
+    shared->length = length;
+    shared->failed = 0;
+    shared->status = 0;
+    pthread_barrierattr_t attributes;
+    pthread_barrierattr_init(&attributes);
+    pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    int barrier_status = pthread_barrier_init(&shared->barrier, &attributes, number_of_workers);
+    pthread_barrierattr_destroy(&attributes);
+    if(barrier_status != 0){
+        munmap(segment, segment_bytes);
+        return 1;
+    }
+    DataParallelWorker worker;
+    worker.shared = shared;
+    worker.slots = (double *)((char *)segment + DATA_PARALLEL_HEADER_BYTES);
+    worker.result = worker.slots + (size_t)number_of_workers*length;
+    worker.coefficients = worker.result + length;
+    for(size_t j=0;j<n;j++) worker.coefficients[j] = gsl_vector_get(coeff_set, j);
+
+    // The workers form one process group, so they can be waited for and killed together
+    unsigned int status = 0, started = 0;
+    pid_t group = 0;
+    for(;started<number_of_workers;started++){
+        pid_t pid = fork();
+        if(pid == 0){
+            setpgid(0, group);
+            worker.rank = started;
+            unsigned int worker_status = task->job == DATA_PARALLEL_MLR_TRAIN ? worker_mlr_train(&worker, task) : worker_gradient_descent(&worker, task);
+            _exit((int)worker_status); // no atexit handlers or stdio flushes of the caller's state
+        }
+        if(pid < 0){
+            status = 1;
+            break;
+        }
+        if(group == 0) group = pid;
+        setpgid(pid, group); // also from here, so the group exists before waitpid below
+    }
+    if(status && started > 0) kill(-group, SIGKILL); // the started workers would wait at the barrier forever
+
+    for(unsigned int finished=0;finished<started;finished++){
+        int exit_status;
+        if(waitpid(-group, &exit_status, 0) < 0){
+            status = 1;
+            break;
+        }
+        if(!WIFEXITED(exit_status) || WEXITSTATUS(exit_status) != 0){
+            // A worker failed or was killed: the others cannot finish an allreduce without it
+            if(status == 0) kill(-group, SIGKILL);
+            status = 1;
+        }
+    }
+
+    if(status == 0) status = shared->status;
+    if(status == 0){
+        for(size_t j=0;j<n;j++) gsl_vector_set(coeff_set, j, worker.coefficients[j]);
+    }
+    pthread_barrier_destroy(&shared->barrier);
+    munmap(segment, segment_bytes);
+    return status;
+}
+
+unsigned int data_parallel_mlr_train(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, unsigned int number_of_workers){
+    size_t n = x_data->size2;
+    if(x_data->size1 == 0 || y_data->size != x_data->size1 || coeff_set->size != n) return 2; // 2 is for arithmatic error
+    DataParallelTask task = {DATA_PARALLEL_MLR_TRAIN, x_data, y_data, regularisation_param, 0, 0};
+    return data_parallel_run(&task, coeff_set, number_of_workers, n*n + n);
+}
+
+unsigned int data_parallel_refine_mlr_gradient_descent(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate, unsigned int number_of_workers){
+    size_t n = x_data->size2;
+    if(x_data->size1 == 0 || y_data->size != x_data->size1 || coeff_set->size != n) return 2; // 2 is for arithmatic error
+    DataParallelTask task = {DATA_PARALLEL_MLR_GRADIENT_DESCENT, x_data, y_data, 0, learning_rate, iterations};
+    return data_parallel_run(&task, coeff_set, number_of_workers, n);
+}
+
+unsigned int data_parallel_logistic_regression_train(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, unsigned int number_of_workers){
+    size_t n = x_data->size2;
+    if(x_data->size1 == 0 || y_data->size != x_data->size1 || weight_set->size != n) return 2; // 2 is for arithmatic error
+    DataParallelTask task = {DATA_PARALLEL_LOGISTIC, x_data, y_data, 0, learning_rate, iterations};
+    return data_parallel_run(&task, weight_set, number_of_workers, n);
+}
@@ -0,0 +1,110 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Launcher for data parallel training on one machine.
+ * Usage: ./launcher [-t model] [-w workers] [-i iterations] [-a learning_rate] [-l lambda] [-o model_file] dataset_file
+ *    -t  mlr (normal equation, default), mlr_gd (gradient descent) or logistic
+ *    -w  worker processes (default: one per CPU)
+ *    -i  iterations of mlr_gd and logistic (default 100)
+ *    -a  learning rate of mlr_gd and logistic (default 0.1)
+ *    -l  λ of mlr (default 1e-9)
+ *    -o  save the coefficients to a model file (see ModelIO)
+ * The data is a Dataset file (see Dataset, `convert` turns a CSV into one). It is mapped once 
+ * and every worker reads its own shard of rows from the shared mapping. Gradient descent starts 
+ * from zero coefficients.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <gsl/gsl_vector.h>
+
+#include "data_parallel.h"
+#include "../Dataset/dataset.h"
+#include "../ModelIO/model_io.h"
+
+static void usage(const char *program){
+    fprintf(stderr, "Usage: %s [-t mlr|mlr_gd|logistic] [-w workers] [-i iterations] [-a learning_rate] [-l lambda] [-o model_file] dataset_file\n", program);
+}
+
+int main(int argc, char **argv){
+    const char *model = "mlr", *output_path = NULL;
+    unsigned int workers = 0, iterations = 100;
+    double learning_rate = 0.1, regularisation_param = 1e-9;
+    int option;
+    while((option = getopt(argc, argv, "t:w:i:a:l:o:")) != -1){
+        switch(option){
+            case 't': model = optarg; break;
+            case 'w': workers = (unsigned int)atoi(optarg); break;
+            case 'i': iterations = (unsigned int)atoi(optarg); break;
+            case 'a': learning_rate = atof(optarg); break;
+            case 'l': regularisation_param = atof(optarg); break;
+            case 'o': output_path = optarg; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if(argc - optind != 1 || (strcmp(model, "mlr") != 0 && strcmp(model, "mlr_gd") != 0 && strcmp(model, "logistic") != 0)){
+        usage(argv[0]);
+        return 1;
+    }
+
+    Dataset dataset;
+    unsigned int status = dataset_open(&dataset, argv[optind]);
+    if(status != 0){
+        fprintf(stderr, "%s: could not be opened as a dataset (error %u)\n", argv[optind], status);
+        return 1;
+    }
+    gsl_matrix *x_data = &dataset.x_data.matrix;
+    gsl_vector *y_data = &dataset.y_data.vector;
+    gsl_vector *coeff_set = gsl_vector_calloc(x_data->size2);
+    if(!coeff_set){
+        dataset_close(&dataset);
+        return 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if(strcmp(model, "mlr") == 0) status = data_parallel_mlr_train(x_data, y_data, coeff_set, regularisation_param, workers);
+    else if(strcmp(model, "mlr_gd") == 0) status = data_parallel_refine_mlr_gradient_descent(x_data, y_data, coeff_set, iterations, learning_rate, workers);
+    else status = data_parallel_logistic_regression_train(y_data, x_data, coeff_set, learning_rate, iterations, workers);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if(status != 0){
+        fprintf(stderr, "Training failed with error code: %u\n", status);
+    }
+    else{
+        printf("Trained %s on %zu rows x %zu features in %.3f s\n", model, x_data->size1, x_data->size2, (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)*1e-9);
+        for(size_t j=0;j<coeff_set->size;j++) printf("Coefficient %zu: %.6f\n", j, gsl_vector_get(coeff_set, j));
+        if(output_path){
+            status = strcmp(model, "logistic") == 0 ? model_save_logistic(output_path, coeff_set) : model_save_mlr(output_path, coeff_set);
+            if(status != 0) fprintf(stderr, "%s: could not be saved (error %u)\n", output_path, status);
+        }
+    }
+
+    gsl_vector_free(coeff_set);
+    dataset_close(&dataset);
+    return status == 0 ? 0 : 1;
+}
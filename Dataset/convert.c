@@ -0,0 +1,83 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Converter from delimited text (CSV/TSV) to the CLearn dataset format.
+ * Usage: ./convert [-d delimiter] [-H] [-t target_column] [-j threads] input.csv output.clds
+ *    -d  field delimiter, a single character or "tab" (default ',')
+ *    -H  the first line is a header and is skipped
+ *    -t  zero based index of the target column (default: the last column)
+ *    -j  number of parser threads (default: one per core)
+ * Every other column becomes a feature, in file order. Blank lines are ignored.
+ * The text is parsed by the parallel CSV reader straight into the mapped output file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dataset.h"
+#include "../CSVReader/csv_reader.h"
+
+int main(int argc, char **argv){
+    CSVReadOptions options;
+    csv_read_options_default(&options);
+    int option;
+    while((option = getopt(argc, argv, "d:Ht:j:")) != -1){
+        switch(option){
+            case 'd': options.delimiter = (strcmp(optarg, "tab") == 0) ? '\t' : optarg[0]; break;
+            case 'H': options.skip_header = 1; break;
+            case 't': options.target_column = atol(optarg); break;
+            case 'j': options.number_of_threads = (unsigned int)atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-d delimiter] [-H] [-t target_column] [-j threads] input output\n", argv[0]);
+                return 1;
+        }
+    }
+    if(argc - optind != 2){
+        fprintf(stderr, "Usage: %s [-d delimiter] [-H] [-t target_column] [-j threads] input output\n", argv[0]);
+        return 1;
+    }
+    const char *input = argv[optind], *output = argv[optind+1];
+
+    size_t number_of_rows, number_of_features;
+    unsigned int status = csv_dimensions(input, &options, &number_of_rows, &number_of_features);
+    if(status == 0 && number_of_features == 0) status = 2;
+    if(status != 0){
+        fprintf(stderr, "%s: %s\n", input, (status == 1) ? "could not be read" : "no data rows, or no feature and target column");
+        return 1;
+    }
+
+    Dataset dataset;
+    if(dataset_create(&dataset, output, number_of_rows, number_of_features) != 0){
+        perror(output);
+        return 1;
+    }
+    status = csv_read(input, &options, &dataset.x_data.matrix, &dataset.y_data.vector);
+    dataset_close(&dataset);
+    if(status != 0){
+        fprintf(stderr, "%s: %s\n", input, (status == 1) ? "could not be read" : "rows with missing or non numeric fields");
+        unlink(output);
+        return 1;
+    }
+    printf("%s: %zu rows, %zu features\n", output, number_of_rows, number_of_features);
+    return 0;
+}
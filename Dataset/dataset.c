@@ -0,0 +1,141 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dataset.h"
+
+static uint64_t align_up(uint64_t value){
+    return (value + DATASET_ALIGNMENT - 1) / DATASET_ALIGNMENT * DATASET_ALIGNMENT;
+}
+
+// Points the gsl views of dataset into its mapping according to header
+static void dataset_bind_views(Dataset *dataset, DatasetHeader *header){
+    char *base = (char *)dataset->mapping;
+    dataset->x_data = gsl_matrix_view_array_with_tda((double *)(base + header->feature_offset), header->number_of_rows, header->number_of_features, header->row_stride);
+    dataset->y_data = gsl_vector_view_array((double *)(base + header->target_offset), header->number_of_rows);
+}
+
+unsigned int dataset_open(Dataset *dataset, const char *path){
+    int file = open(path, O_RDONLY);
+    if(file < 0) return 1; // 1 is for system error
+
+    struct stat file_status;
+    if(fstat(file, &file_status) != 0){
+        close(file);
+        return 1;
+    }
+    size_t file_size = (size_t)file_status.st_size;
+    if(file_size < sizeof(DatasetHeader)){
+        close(file);
+        return 2; // 2 is for an invalid file
+    }
+
+    // Private writable mapping: callers get a plain (non const) gsl_matrix, writes never reach the file
+    void *mapping = mmap(NULL, file_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if(mapping == MAP_FAILED) return 1;
+
+    DatasetHeader *header = (DatasetHeader *)mapping;
+    uint64_t feature_bytes = header->number_of_rows * header->row_stride * sizeof(double);
+    int valid = memcmp(header->magic, DATASET_MAGIC, 4) == 0
+             && header->version == DATASET_VERSION
+             && header->number_of_rows > 0
+             && header->number_of_features > 0
+             && header->row_stride >= header->number_of_features
+             && header->feature_offset % DATASET_ALIGNMENT == 0
+             && header->target_offset % DATASET_ALIGNMENT == 0
+             && header->feature_offset >= sizeof(DatasetHeader)
+             // sizes are checked against overflow before being compared with the file
+             && header->row_stride <= (UINT64_MAX / sizeof(double)) / header->number_of_rows
+             && header->feature_offset <= file_size && feature_bytes <= file_size - header->feature_offset
+             && header->target_offset >= header->feature_offset + feature_bytes
+             && header->target_offset <= file_size && header->number_of_rows * sizeof(double) <= file_size - header->target_offset;
+    if(!valid){
+        munmap(mapping, file_size);
+        return 2;
+    }
+
+    dataset->mapping = mapping;
+    dataset->mapping_size = file_size;
+    dataset_bind_views(dataset, header);
+
+    // Training makes front to back passes over the rows
+    madvise(mapping, file_size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+unsigned int dataset_create(Dataset *dataset, const char *path, size_t number_of_rows, size_t number_of_features){
+    if(number_of_rows == 0 || number_of_features == 0) return 2;
+    if(number_of_features > (SIZE_MAX / sizeof(double)) / number_of_rows) return 2;
+
+    DatasetHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DATASET_MAGIC, 4);
+    header.version = DATASET_VERSION;
+    header.number_of_rows = number_of_rows;
+    header.number_of_features = number_of_features;
+    header.row_stride = number_of_features;
+    header.feature_offset = align_up(sizeof(DatasetHeader));
+    header.target_offset = align_up(header.feature_offset + (uint64_t)number_of_rows * number_of_features * sizeof(double));
+    size_t file_size = (size_t)(header.target_offset + (uint64_t)number_of_rows * sizeof(double));
+
+    int file = open(path, O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if(file < 0) return 1;
+    if(ftruncate(file, (off_t)file_size) != 0){
+        close(file);
+        return 1;
+    }
+    void *mapping = mmap(NULL, file_size, PROT_READ|PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if(mapping == MAP_FAILED) return 1;
+
+    memcpy(mapping, &header, sizeof(header));
+    dataset->mapping = mapping;
+    dataset->mapping_size = file_size;
+    dataset_bind_views(dataset, &header);
+    return 0;
+}
+
+unsigned int dataset_write(const char *path, gsl_matrix *x_data, gsl_vector *y_data){
+    if(x_data->size1 != y_data->size) return 2;
+
+    Dataset dataset;
+    unsigned int status = dataset_create(&dataset, path, x_data->size1, x_data->size2);
+    if(status != 0) return status;
+
+    gsl_matrix_memcpy(&dataset.x_data.matrix, x_data);
+    gsl_vector_memcpy(&dataset.y_data.vector, y_data);
+    dataset_close(&dataset);
+    return 0;
+}
+
+void dataset_close(Dataset *dataset){
+    if(!dataset->mapping) return;
+    // Only has an effect on shared (created) mappings, private ones have nothing to write back
+    msync(dataset->mapping, dataset->mapping_size, MS_SYNC);
+    munmap(dataset->mapping, dataset->mapping_size);
+    dataset->mapping = NULL;
+    dataset->mapping_size = 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+/*
+ * On-disk layout of a CLearn dataset file (all values in the byte order of the machine that wrote it):
+ *
+ *   offset 0                : DatasetHeader (64 bytes)
+ *   offset feature_offset   : rows x row_stride doubles, row-major (64-byte aligned)
+ *   offset target_offset    : rows doubles, one target per row (64-byte aligned)
+ *
+ * Because the blocks are stored exactly as GSL keeps a matrix and a vector in memory, 
+ * the file can be mapped and used in place without parsing or copying.
+ */
+
+#define DATASET_MAGIC "CLDS"
+#define DATASET_VERSION 1
+#define DATASET_ALIGNMENT 64
+
+typedef struct {
+char magic[4];              // "CLDS"
+uint32_t version;           // DATASET_VERSION, also reveals a byte order mismatch
+uint64_t number_of_rows;
+uint64_t number_of_features;
+uint64_t row_stride;        // doubles from one row to the next (>= number_of_features)
+uint64_t feature_offset;    // byte offset of the feature block
+uint64_t target_offset;     // byte offset of the target column
+uint64_t reserved[2];
+}DatasetHeader;
+
+typedef struct {
+gsl_matrix_view x_data;     // (number_of_rows x number_of_features) view into the mapping
+gsl_vector_view y_data;     // number_of_rows view into the mapping
+void *mapping;
+size_t mapping_size;
+}Dataset;
+
+
+/*
+ * Function: dataset_open
+ * ----------------------------
+ */
+unsigned int dataset_open(Dataset *dataset, const char *path);
+/* This function opens a dataset file and memory maps it. `dataset->x_data.matrix` and 
+ * `dataset->y_data.vector` are then ordinary `gsl_matrix`/`gsl_vector` objects whose data 
+ * points straight into the mapping, so they can be passed to `mlr_train`, 
+ * `logistic_regression_train`, etc. No data is read or copied when opening: pages are loaded 
+ * by the operating system the first time training touches them, so opening even a very large 
+ * file takes about as long as opening a small one.
+ *
+ * The mapping is private (copy-on-write): functions that write into the matrix only change the 
+ * touched pages in memory, the file itself is never modified.
+ *
+ * Arguments:
+ *    - dataset: A pointer to the `Dataset` structure that receives the mapping and the views.
+ *    - path: The path of the dataset file.
+ *
+ * Returns:
+ *    - `0` if the dataset was mapped.
+ *    - `1` if there was a system error (the file could not be opened or mapped).
+ *    - `2` if the file is not a valid dataset (bad magic, version, byte order or sizes).
+ *
+ * Notes:
+ *    - Every successfully opened dataset must be released with `dataset_close`.
+ *    - The views become invalid after `dataset_close`.
+ */
+
+
+/*
+ * Function: dataset_create
+ * ----------------------------
+ */
+unsigned int dataset_create(Dataset *dataset, const char *path, size_t number_of_rows, size_t number_of_features);
+/* This function creates (or replaces) a dataset file sized for `number_of_rows` rows of 
+ * `number_of_features` features, writes its header and maps it writable. The caller then fills 
+ * `dataset->x_data.matrix` and `dataset->y_data.vector` directly (e.g. while parsing a text file), 
+ * and `dataset_close` makes sure everything reaches the file.
+ *
+ * Arguments:
+ *    - dataset: A pointer to the `Dataset` structure that receives the mapping and the views.
+ *    - path: The path of the dataset file to create.
+ *    - number_of_rows: The number of rows (must be at least 1).
+ *    - number_of_features: The number of features per row (must be at least 1).
+ *
+ * Returns:
+ *    - `0` if the dataset was created.
+ *    - `1` if there was a system error (e.g., the file could not be created, resized or mapped).
+ *    - `2` if the requested size is invalid.
+ */
+
+
+/*
+ * Function: dataset_write
+ * ----------------------------
+ */
+unsigned int dataset_write(const char *path, gsl_matrix *x_data, gsl_vector *y_data);
+/* This function stores an in-memory data set as a dataset file, using `dataset_create`.
+ *
+ * Arguments:
+ *    - path: The path of the dataset file to create.
+ *    - x_data: A `gsl_matrix` with one row per data point.
+ *    - y_data: A `gsl_vector` with one target per row of `x_data`.
+ *
+ * Returns:
+ *    - `0` if the file was written.
+ *    - `1` if there was a system error.
+ *    - `2` if the sizes of `x_data` and `y_data` do not match or are empty.
+ */
+
+
+/*
+ * Function: dataset_close
+ * ----------------------------
+ */
+void dataset_close(Dataset *dataset);
+/* This function unmaps a dataset opened with `dataset_open` or `dataset_create`. For created 
+ * datasets the written data is flushed to the file first.
+ *
+ * Arguments:
+ *    - dataset: A pointer to the `Dataset` to release.
+ */
+
+#endif // DATASET_H
@@ -0,0 +1,72 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "dataset.h"
+#include "../MultipleLinearRegression/multiple_linear_regression.h"
+
+int main() {
+    // Example data, the first column is the intercept column (all ones)
+    double x_data_array[5][3] = {
+        {1, 2, 5},
+        {1, 3, 6},
+        {1, 4, 8},
+        {1, 5, 8},
+        {1, 6, 9}
+    };
+    double y_data_array[5] = {19, 23, 29, 31, 35};
+
+    gsl_matrix_view x_data = gsl_matrix_view_array(&x_data_array[0][0], 5, 3);
+    gsl_vector_view y_data = gsl_vector_view_array(y_data_array, 5);
+
+    // Store the data set once...
+    if (dataset_write("example.clds", &x_data.matrix, &y_data.vector) != 0) {
+        printf("Could not write example.clds\n");
+        return 1;
+    }
+
+    // ...and map it for training, no parsing or copying involved
+    Dataset dataset;
+    unsigned int result = dataset_open(&dataset, "example.clds");
+    if (result != 0) {
+        printf("Could not open example.clds, error code: %u\n", result);
+        return 1;
+    }
+    printf("Mapped %zu rows with %zu features\n", dataset.x_data.matrix.size1, dataset.x_data.matrix.size2);
+
+    gsl_vector *coeff_set = gsl_vector_alloc(dataset.x_data.matrix.size2);
+    result = mlr_train(&dataset.x_data.matrix, &dataset.y_data.vector, coeff_set, 0.01);
+    if (result == 0) {
+        printf("Coefficients trained on the mapped data:\n");
+        for (size_t i = 0; i < coeff_set->size; i++) {
+            printf("Coefficient %zu: %.4f\n", i, gsl_vector_get(coeff_set, i));
+        }
+    } else {
+        printf("Training failed with error code: %u\n", result);
+    }
+
+    gsl_vector_free(coeff_set);
+    dataset_close(&dataset);
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "feature_expansion.h"
+#include "../MultipleLinearRegression/multiple_linear_regression.h"
+
+// Bytes of expanded rows generated at a time, about the size of an L2 cache
+#define FEATURE_EXPANSION_TILE_BYTES (256*1024)
+// Fewest rows per tile, so that the products still work on blocks for very wide expansions
+#define FEATURE_EXPANSION_MIN_TILE_ROWS 16
+
+// Rows of x_data expanded so far by expansion_reader
+typedef struct {
+const FeatureExpansion *expansion;
+gsl_matrix *x_data;
+gsl_vector *y_data;
+size_t next_row;
+}ExpansionReader;
+
+size_t feature_expansion_size(const FeatureExpansion *expansion){
+    size_t d = expansion->number_of_inputs;
+    if(expansion->number_of_interactions && !expansion->interactions) return 0;
+    for(size_t k=0;k<expansion->number_of_interactions;k++){
+        if(expansion->interactions[k].first >= d || expansion->interactions[k].second >= d) return 0;
+    }
+    return (expansion->bias ? 1 : 0) + (size_t)expansion->degree*d + expansion->number_of_interactions;
+}
+
+// Rows per tile for an expansion of number_of_columns columns, at most number_of_data
+static size_t tile_rows(size_t number_of_columns, size_t number_of_data){
+    size_t rows = FEATURE_EXPANSION_TILE_BYTES/(number_of_columns*sizeof(double));
+    if(rows < FEATURE_EXPANSION_MIN_TILE_ROWS) rows = FEATURE_EXPANSION_MIN_TILE_ROWS;
+    if(rows > number_of_data) rows = number_of_data;
+    return rows;
+}
+
+// feature_expansion_expand without the checks
+static void expand_rows(const FeatureExpansion *expansion, gsl_matrix *x_rows, gsl_matrix *expanded_rows){
+    size_t d = expansion->number_of_inputs;
+    for(size_t i=0;i<x_rows->size1;i++){
+        const double *x = gsl_matrix_const_ptr(x_rows, i, 0);
+        double *out = gsl_matrix_ptr(expanded_rows, i, 0);
+        if(expansion->bias) *out++ = 1.0;
+        if(expansion->degree >= 1){
+            memcpy(out, x, d*sizeof(double));
+            out += d;
+        }
+        // Every power is the previous one times x
+        for(unsigned int p=2;p<=expansion->degree;p++){
+            for(size_t j=0;j<d;j++) out[j] = out[j - d]*x[j];
+            out += d;
+        }
+        for(size_t k=0;k<expansion->number_of_interactions;k++){
+            *out++ = x[expansion->interactions[k].first]*x[expansion->interactions[k].second];
+        }
+    }
+}
+
+unsigned int feature_expansion_expand(const FeatureExpansion *expansion, gsl_matrix *x_rows, gsl_matrix *expanded_rows){
+    size_t n = feature_expansion_size(expansion);
+    if(n==0||x_rows->size2!=expansion->number_of_inputs||expanded_rows->size1!=x_rows->size1||expanded_rows->size2!=n) return 2;
+    expand_rows(expansion, x_rows, expanded_rows);
+    return 0; //No errors
+}
+
+// mlr_row_block_reader that expands the next rows of the raw data into x_block
+static long expansion_reader(gsl_matrix *x_block, gsl_vector *y_block, void *reader_context){
+    ExpansionReader *reader = reader_context;
+    size_t rows = reader->x_data->size1 - reader->next_row;
+    if(rows > x_block->size1) rows = x_block->size1;
+    if(rows == 0) return 0;
+    gsl_matrix_view x_rows = gsl_matrix_submatrix(reader->x_data, reader->next_row, 0, rows, reader->x_data->size2);
+    gsl_matrix_view expanded_rows = gsl_matrix_submatrix(x_block, 0, 0, rows, x_block->size2);
+    gsl_vector_view y_rows = gsl_vector_subvector(reader->y_data, reader->next_row, rows);
+    gsl_vector_view y_out = gsl_vector_subvector(y_block, 0, rows);
+    expand_rows(reader->expansion, &x_rows.matrix, &expanded_rows.matrix);
+    gsl_vector_memcpy(&y_out.vector, &y_rows.vector);
+    reader->next_row += rows;
+    return (long)rows;
+}
+
+unsigned int feature_expansion_mlr_train(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param){
+    size_t n = feature_expansion_size(expansion);
+    size_t m = x_data->size1;
+    if(n==0||m==0||x_data->size2!=expansion->number_of_inputs||y_data->size!=m||coeff_set->size!=n) return 2;
+
+    ExpansionReader reader = {expansion, x_data, y_data, 0};
+    return mlr_train_blocked(expansion_reader, &reader, n, tile_rows(n, m), coeff_set, regularisation_param);
+}
+
+unsigned int feature_expansion_mlr_gradient_descent(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate){
+    size_t n = feature_expansion_size(expansion);
+    size_t m = x_data->size1;
+    if(n==0||m==0||x_data->size2!=expansion->number_of_inputs||y_data->size!=m||coeff_set->size!=n) return 2;
+
+    size_t rows_per_tile = tile_rows(n, m);
+    gsl_matrix *tile = gsl_matrix_alloc(rows_per_tile, n);
+    gsl_vector *error_set = gsl_vector_alloc(rows_per_tile);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    unsigned int status = 0;
+    if(!tile||!error_set||!gradient){
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    for(unsigned int i=0;i<iterations;i++){
+        gsl_vector_set_zero(gradient);
+        for(size_t start=0;start<m;start+=rows_per_tile){
+            size_t rows = m - start < rows_per_tile ? m - start : rows_per_tile;
+            gsl_matrix_view x_rows = gsl_matrix_submatrix(x_data, start, 0, rows, x_data->size2);
+            gsl_matrix_view expanded_rows = gsl_matrix_submatrix(tile, 0, 0, rows, n);
+            gsl_vector_view y_rows = gsl_vector_subvector(y_data, start, rows);
+            gsl_vector_view error_rows = gsl_vector_subvector(error_set, 0, rows);
+            expand_rows(expansion, &x_rows.matrix, &expanded_rows.matrix);
+
+            // error = expanded_rows*coeff_set - y, then gradient += 1/m * expanded_rows^T * error while the tile is in cache
+            gsl_vector_memcpy(&error_rows.vector, &y_rows.vector);
+            gsl_blas_dgemv(CblasNoTrans, 1.0, &expanded_rows.matrix, coeff_set, -1.0, &error_rows.vector);
+            gsl_blas_dgemv(CblasTrans, 1.0/m, &expanded_rows.matrix, &error_rows.vector, 1.0, gradient);
+        }
+        // coeff_set = coeff_set - learning_rate*gradient
+        gsl_blas_daxpy(-learning_rate, gradient, coeff_set);
+    }
+
+cleanup:
+    if(tile)gsl_matrix_free(tile);
+    if(error_set)gsl_vector_free(error_set);
+    if(gradient)gsl_vector_free(gradient);
+    return status;
+}
+
+unsigned int feature_expansion_mlr_predict(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_new, gsl_vector *coeff_set){
+    size_t n = feature_expansion_size(expansion);
+    size_t m = x_data->size1;
+    if(n==0||x_data->size2!=expansion->number_of_inputs||y_new->size!=m||coeff_set->size!=n) return 2;
+    if(m==0) return 0;
+
+    size_t rows_per_tile = tile_rows(n, m);
+    gsl_matrix *tile = gsl_matrix_alloc(rows_per_tile, n);
+    if(!tile) return 1; // 1 is for system error
+    for(size_t start=0;start<m;start+=rows_per_tile){
+        size_t rows = m - start < rows_per_tile ? m - start : rows_per_tile;
+        gsl_matrix_view x_rows = gsl_matrix_submatrix(x_data, start, 0, rows, x_data->size2);
+        gsl_matrix_view expanded_rows = gsl_matrix_submatrix(tile, 0, 0, rows, n);
+        gsl_vector_view y_rows = gsl_vector_subvector(y_new, start, rows);
+        expand_rows(expansion, &x_rows.matrix, &expanded_rows.matrix);
+        gsl_blas_dgemv(CblasNoTrans, 1.0, &expanded_rows.matrix, coeff_set, 0.0, &y_rows.vector);
+    }
+    gsl_matrix_free(tile);
+    return 0; //No errors
+}
@@ -0,0 +1,158 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FEATURE_EXPANSION_H
+#define FEATURE_EXPANSION_H
+
+#include <stddef.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+/*
+ * Polynomial and interaction features without the expanded matrix.
+ *
+ * A FeatureExpansion describes how d raw columns x_1 ... x_d become the columns the model is 
+ * trained on, in this order:
+ *    [1]                               if bias is set
+ *    x_1 ... x_d                       if degree >= 1
+ *    x_1^2 ... x_d^2                   if degree >= 2
+ *    ...
+ *    x_1^degree ... x_d^degree
+ *    x_a * x_b                         for every chosen interaction (a, b)
+ * The functions below never hold more than one tile of expanded rows (about 256 KiB, so it stays 
+ * in cache while it is used): every tile is generated from the raw rows, consumed, and 
+ * overwritten by the next one. Memory therefore grows with the raw width d and the expanded 
+ * width N, not with rows x N.
+ */
+
+// Product x_first * x_second of two raw columns (zero based, first == second gives a square)
+typedef struct {
+size_t first;
+size_t second;
+}FeatureInteraction;
+
+typedef struct {
+size_t number_of_inputs;                    // d, the columns of the raw data
+unsigned int degree;                        // highest power of every raw column, 0 for none
+const FeatureInteraction *interactions;     // chosen pairwise products, may be NULL
+size_t number_of_interactions;
+int bias;                                   // 1 to start with a column of ones
+}FeatureExpansion;
+
+
+/*
+ * Function: feature_expansion_size
+ * ----------------------------
+ */
+size_t feature_expansion_size(const FeatureExpansion *expansion);
+/*
+ * Returns the number of expanded columns N = bias + degree * d + number_of_interactions, i.e. the 
+ * number of coefficients of a model trained on the expansion, or 0 if the expansion is invalid 
+ * (no columns, or an interaction refers to a column >= d).
+ */
+
+
+/*
+ * Function: feature_expansion_expand
+ * ----------------------------
+ */
+unsigned int feature_expansion_expand(const FeatureExpansion *expansion, gsl_matrix *x_rows, gsl_matrix *expanded_rows);
+/*
+ * Writes the expanded columns of the raw rows `x_rows` (k x d) into `expanded_rows` (k x N). 
+ * This is what the functions below do tile by tile; it is also the way to get a few expanded 
+ * rows, e.g. to inspect them.
+ *
+ * Returns:
+ *    - 0 on success.
+ *    - 2 if the expansion is invalid or the sizes do not match.
+ */
+
+
+/*
+ * Function: feature_expansion_mlr_train
+ * ----------------------------
+ */
+unsigned int feature_expansion_mlr_train(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param);
+/*
+ * Fits the same model as `mlr_train` on the expanded data, β = (X^T X + λI)^(-1) X^T Y, where X 
+ * is the expansion of `x_data`. The rows are expanded one tile at a time and fed to 
+ * `mlr_train_blocked`, which adds X_b^T X_b and X_b^T Y_b of every tile and solves with a 
+ * Cholesky decomposition. Memory is N^2 + N doubles plus one tile.
+ *
+ * Arguments:
+ *    - expansion: The FeatureExpansion, with `number_of_inputs` equal to the columns of `x_data`.
+ *    - x_data: The raw (m x d) data.
+ *    - y_data: The m targets.
+ *    - coeff_set: A vector of N entries receiving β, in the order of the expanded columns.
+ *    - regularisation_param: λ, as for `mlr_train`. Powers of a column are strongly correlated, 
+ *      so a small λ (or scaled raw data) keeps X^T X well conditioned at higher degrees.
+ *
+ * Returns:
+ *    - 0 on success.
+ *    - 1 if an allocation failed.
+ *    - 2 if the expansion is invalid, the sizes do not match or X^T X + λI is not positive 
+ *      definite.
+ */
+
+
+/*
+ * Function: feature_expansion_mlr_gradient_descent
+ * ----------------------------
+ */
+unsigned int feature_expansion_mlr_gradient_descent(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate);
+/*
+ * Same as `refine_mlr_gradient_descent` on the expanded data: every iteration sets
+ *    β = β - learning_rate * (1/m) * X^T (Xβ - Y)
+ * Each tile is expanded once per iteration and used for both products while it is in cache, so 
+ * an iteration reads the raw data once. Memory is one tile plus N + tile rows doubles.
+ *
+ * Arguments:
+ *    - expansion, x_data, y_data: As for `feature_expansion_mlr_train`.
+ *    - coeff_set: The N starting coefficients, updated in place.
+ *    - iterations, learning_rate: As for `refine_mlr_gradient_descent`.
+ *
+ * Returns:
+ *    - 0 on success.
+ *    - 1 if an allocation failed.
+ *    - 2 if the expansion is invalid or the sizes do not match.
+ */
+
+
+/*
+ * Function: feature_expansion_mlr_predict
+ * ----------------------------
+ */
+unsigned int feature_expansion_mlr_predict(const FeatureExpansion *expansion, gsl_matrix *x_data, gsl_vector *y_new, gsl_vector *coeff_set);
+/*
+ * Same as `mlr_predict` on the expanded data, y_new = Xβ, one tile at a time.
+ *
+ * Arguments:
+ *    - expansion: The FeatureExpansion the coefficients were trained with.
+ *    - x_data: The raw (m x d) rows to predict.
+ *    - y_new: A vector of m entries receiving the predictions.
+ *    - coeff_set: The N coefficients.
+ *
+ * Returns:
+ *    - 0 on success.
+ *    - 1 if an allocation failed.
+ *    - 2 if the expansion is invalid or the sizes do not match.
+ */
+
+#endif // FEATURE_EXPANSION_H
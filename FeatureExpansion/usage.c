@@ -0,0 +1,84 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "feature_expansion.h"
+
+#define ROWS 5000
+
+int main() {
+    // Two raw columns and a curved target: y = 1 + 2*a - 0.5*a^2 + 0.3*b^3 + 0.7*a*b + noise
+    gsl_matrix *x_data = gsl_matrix_alloc(ROWS, 2);
+    gsl_vector *y_data = gsl_vector_alloc(ROWS);
+    srand(11);
+    for (size_t i = 0; i < ROWS; i++) {
+        double a = 4.0 * rand() / RAND_MAX - 2.0;
+        double b = 4.0 * rand() / RAND_MAX - 2.0;
+        gsl_matrix_set(x_data, i, 0, a);
+        gsl_matrix_set(x_data, i, 1, b);
+        gsl_vector_set(y_data, i, 1 + 2 * a - 0.5 * a * a + 0.3 * b * b * b + 0.7 * a * b + 0.01 * ((double)rand() / RAND_MAX - 0.5));
+    }
+
+    // Bias, a, b, a^2, b^2, a^3, b^3 and the product a*b: 8 columns that are never stored
+    FeatureInteraction interactions[] = {{0, 1}};
+    FeatureExpansion expansion = {2, 3, interactions, 1, 1};
+    const char *names[] = {"1", "a", "b", "a^2", "b^2", "a^3", "b^3", "a*b"};
+    size_t n = feature_expansion_size(&expansion);
+    gsl_vector *coeff_set = gsl_vector_calloc(n);
+
+    unsigned int status = feature_expansion_mlr_train(&expansion, x_data, y_data, coeff_set, 1e-9);
+    if (status != 0) {
+        printf("Training failed with error code: %u\n", status);
+        return 1;
+    }
+    printf("Coefficients of the expanded columns:\n");
+    for (size_t j = 0; j < n; j++) printf("%-4s %9.4f\n", names[j], gsl_vector_get(coeff_set, j));
+
+    // A few more gradient descent steps on the same expansion
+    status = feature_expansion_mlr_gradient_descent(&expansion, x_data, y_data, coeff_set, 10, 0.01);
+    if (status != 0) {
+        printf("Gradient descent failed with error code: %u\n", status);
+        return 1;
+    }
+
+    gsl_matrix *x_new = gsl_matrix_alloc(3, 2);
+    gsl_vector *y_new = gsl_vector_alloc(3);
+    double points[3][2] = {{0, 0}, {1, -1}, {-1.5, 2}};
+    for (size_t i = 0; i < 3; i++) {
+        gsl_matrix_set(x_new, i, 0, points[i][0]);
+        gsl_matrix_set(x_new, i, 1, points[i][1]);
+    }
+    feature_expansion_mlr_predict(&expansion, x_new, y_new, coeff_set);
+    for (size_t i = 0; i < 3; i++) {
+        double a = points[i][0], b = points[i][1];
+        printf("a = %5.2f, b = %5.2f: predicted %8.4f, true %8.4f\n", a, b, gsl_vector_get(y_new, i), 1 + 2 * a - 0.5 * a * a + 0.3 * b * b * b + 0.7 * a * b);
+    }
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(coeff_set);
+    gsl_matrix_free(x_new);
+    gsl_vector_free(y_new);
+    return 0;
+}
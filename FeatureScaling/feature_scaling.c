@@ -0,0 +1,128 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <math.h>
+
+#include "feature_scaling.h"
+
+/*
+Fills mean, deviation and the constant column of FeatureScaling from one pass over the rows.
+The sums are taken of x - x_0j (the first row), which keeps them accurate for columns far from 
+0 and exactly 0 for constant ones
+ */
+void feature_scaling_fit(gsl_matrix *x_data, gsl_vector *mean, gsl_vector *deviation, size_t *constant_column){
+    size_t m = x_data->size1, n = x_data->size2;
+    const double *first = gsl_matrix_const_ptr(x_data, 0, 0);
+    double *sum = mean->data, *square_sum = deviation->data;
+    size_t sum_stride = mean->stride, square_stride = deviation->stride;
+    gsl_vector_set_zero(mean);
+    gsl_vector_set_zero(deviation);
+    for(size_t i=1;i<m;i++){
+        const double *row = gsl_matrix_const_ptr(x_data, i, 0);
+        for(size_t j=0;j<n;j++){
+            double shifted = row[j] - first[j];
+            sum[j*sum_stride] += shifted;
+            square_sum[j*square_stride] += shifted*shifted;
+        }
+    }
+    *constant_column = n;
+    for(size_t j=0;j<n && *constant_column==n;j++){
+        if(square_sum[j*square_stride] == 0 && first[j] != 0) *constant_column = j;
+    }
+    for(size_t j=0;j<n;j++){
+        double shifted_mean = sum[j*sum_stride]/m;
+        double variance = square_sum[j*square_stride]/m - shifted_mean*shifted_mean;
+        double column_mean = first[j] + shifted_mean;
+        double centre = 0, spread = 1;
+        if(square_sum[j*square_stride] != 0){
+            // Without a constant column to absorb the shift only the root mean square is divided out
+            if(*constant_column < n) centre = column_mean;
+            else variance += column_mean*column_mean;
+            if(variance > 0) spread = sqrt(variance);
+        }
+        sum[j*sum_stride] = centre;
+        square_sum[j*square_stride] = spread;
+    }
+}
+
+// Coefficients of the standardised columns that give the same predictions as coeff_set
+void feature_scaling_to_scaled(FeatureScaling *scaling, double constant_value, gsl_vector *coeff_set, gsl_vector *scaled_set){
+    size_t n = coeff_set->size;
+    double shift = 0;
+    for(size_t j=0;j<n;j++){
+        double coefficient = gsl_vector_get(coeff_set, j);
+        shift += coefficient*gsl_vector_get(scaling->mean, j);
+        gsl_vector_set(scaled_set, j, coefficient*gsl_vector_get(scaling->deviation, j));
+    }
+    if(scaling->constant_column < n) *gsl_vector_ptr(scaled_set, scaling->constant_column) += shift/constant_value;
+}
+
+// Inverse of feature_scaling_to_scaled: coefficients of the original columns
+void feature_scaling_from_scaled(FeatureScaling *scaling, double constant_value, gsl_vector *scaled_set, gsl_vector *coeff_set){
+    size_t n = coeff_set->size;
+    double shift = 0;
+    for(size_t j=0;j<n;j++){
+        double coefficient = gsl_vector_get(scaled_set, j)/gsl_vector_get(scaling->deviation, j);
+        shift += coefficient*gsl_vector_get(scaling->mean, j);
+        gsl_vector_set(coeff_set, j, coefficient);
+    }
+    if(scaling->constant_column < n) *gsl_vector_ptr(coeff_set, scaling->constant_column) -= shift/constant_value;
+}
+
+/*
+Turns gradient = X^T e (any factor) into the gradient for the standardised columns,
+(X^T e - mean_j Σe) / deviation_j, where Σe is read off the constant column's entry
+ */
+void feature_scaling_gradient(FeatureScaling *scaling, double constant_value, gsl_vector *gradient){
+    size_t n = gradient->size;
+    double error_sum = scaling->constant_column < n ? gsl_vector_get(gradient, scaling->constant_column)/constant_value : 0;
+    for(size_t j=0;j<n;j++){
+        double value = gsl_vector_get(gradient, j) - gsl_vector_get(scaling->mean, j)*error_sum;
+        gsl_vector_set(gradient, j, value/gsl_vector_get(scaling->deviation, j));
+    }
+}
+
+/*
+Points scaling at the statistics to train with: the caller's (computed unless reuse is set) or, 
+if it passed NULL, own ones in local (whose vectors the caller frees). Returns 1 if an 
+allocation failed, 2 if the caller's vectors do not have one entry per feature or the reused 
+constant column is 0 in x_data. constant_value receives that column's value
+ */
+unsigned int feature_scaling_prepare(gsl_matrix *x_data, FeatureScaling *caller, FeatureScaling *local, FeatureScaling **scaling, double *constant_value){
+    size_t n = x_data->size2;
+    if(caller){
+        if(!caller->mean || !caller->deviation || caller->mean->size != n || caller->deviation->size != n) return 2;
+        if(caller->reuse && caller->constant_column > n) return 2;
+        *scaling = caller;
+    }
+    else{
+        local->reuse = 0;
+        local->mean = gsl_vector_alloc(n);
+        local->deviation = gsl_vector_alloc(n);
+        if(!local->mean || !local->deviation) return 1;
+        *scaling = local;
+    }
+    if(!(*scaling)->reuse) feature_scaling_fit(x_data, (*scaling)->mean, (*scaling)->deviation, &(*scaling)->constant_column);
+    *constant_value = (*scaling)->constant_column < n ? gsl_matrix_get(x_data, 0, (*scaling)->constant_column) : 1;
+    if(*constant_value == 0) return 2;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FEATURE_SCALING_H
+#define FEATURE_SCALING_H
+
+#include <stddef.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+/*
+ * Standardisation used by the `_scaled` gradient descent functions of the models (e.g. 
+ * `refine_mlr_gradient_descent_scaled`, `logistic_regression_train_scaled`). They train on
+ *    x'_j = (x_j - mean_j) / deviation_j
+ * without ever writing x' : the statistics come from one pass over the rows, the scaling is 
+ * applied to the coefficients and the gradient (O(n) per iteration) instead of to the data, and 
+ * the returned coefficients are those of the original columns, so prediction is unchanged.
+ *
+ * Centring moves the intercept, so columns are only centred when the data has a non zero 
+ * constant column (normally the bias column of ones) to absorb it. Without one, every column 
+ * is divided by its root mean square instead. Constant and all zero columns are left as they are 
+ * (mean 0, deviation 1).
+ */
+
+typedef struct {
+// Settings, chosen by the caller
+int reuse;                  // 1 to train with the statistics already held below instead of computing them
+// Statistics, vectors of the number of features allocated by the caller, filled by the training function
+gsl_vector *mean;           // subtracted from each column, 0 for columns that are not centred
+gsl_vector *deviation;      // each column is divided by it, 1 for columns that are not scaled
+size_t constant_column;     // first non zero constant column, the number of features if there is none
+}FeatureScaling;
+
+
+/*
+ * Function: feature_scaling_fit
+ * ----------------------------
+ */
+void feature_scaling_fit(gsl_matrix *x_data, gsl_vector *mean, gsl_vector *deviation, size_t *constant_column);
+/*
+ * Computes the statistics of the columns of x_data in one pass over the rows. The sums are taken 
+ * of x - x_0j (the first row), which keeps them accurate for columns far from 0 and exactly 0 for 
+ * constant ones.
+ *
+ * Arguments:
+ *    - x_data: The data, one row per sample (at least one row).
+ *    - mean, deviation: Vectors of the number of features receiving the statistics.
+ *    - constant_column: Receives the first non zero constant column, the number of features if 
+ *      there is none.
+ */
+
+
+/*
+ * Function: feature_scaling_to_scaled
+ * ----------------------------
+ */
+void feature_scaling_to_scaled(FeatureScaling *scaling, double constant_value, gsl_vector *coeff_set, gsl_vector *scaled_set);
+/*
+ * Converts coefficients of the original columns into the coefficients of the standardised columns 
+ * that give the same predictions. O(n).
+ *
+ * Arguments:
+ *    - scaling: The statistics.
+ *    - constant_value: The value of the constant column (1 if there is none).
+ *    - coeff_set: The coefficients of the original columns.
+ *    - scaled_set: Receives the coefficients of the standardised columns.
+ */
+
+
+/*
+ * Function: feature_scaling_from_scaled
+ * ----------------------------
+ */
+void feature_scaling_from_scaled(FeatureScaling *scaling, double constant_value, gsl_vector *scaled_set, gsl_vector *coeff_set);
+/*
+ * Inverse of `feature_scaling_to_scaled`: converts coefficients of the standardised columns back 
+ * into those of the original columns. O(n).
+ */
+
+
+/*
+ * Function: feature_scaling_gradient
+ * ----------------------------
+ */
+void feature_scaling_gradient(FeatureScaling *scaling, double constant_value, gsl_vector *gradient);
+/*
+ * Turns a gradient X^T e (with any factor) of the original columns, in place, into the gradient 
+ * for the standardised columns
+ *    (X^T e - mean_j Σe) / deviation_j
+ * where Σe is read off the entry of the constant column, so no pass over the data is needed.
+ */
+
+
+/*
+ * Function: feature_scaling_prepare
+ * ----------------------------
+ */
+unsigned int feature_scaling_prepare(gsl_matrix *x_data, FeatureScaling *caller, FeatureScaling *local, FeatureScaling **scaling, double *constant_value);
+/*
+ * Chooses the statistics a `_scaled` training function trains with and computes them unless they 
+ * are reused.
+ *
+ * Arguments:
+ *    - x_data: The training data.
+ *    - caller: The caller's FeatureScaling, or NULL to use statistics of its own.
+ *    - local: Used when caller is NULL: its vectors are allocated here and must be freed by the 
+ *      training function (also when an error is returned).
+ *    - scaling: Receives caller or local.
+ *    - constant_value: Receives the value of the constant column (1 if there is none).
+ *
+ * Returns:
+ *    - `0` if the statistics are ready.
+ *    - `1` if there was a system error (memory allocation failure).
+ *    - `2` if the caller's vectors do not have one entry per feature, or the reused constant 
+ *      column is out of range or 0 in x_data.
+ */
+
+#endif // FEATURE_SCALING_H
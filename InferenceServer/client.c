@@ -0,0 +1,173 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Load generator for the inference server.
+ * Usage: ./client [-c connections] [-n requests] socket_path
+ *    -c  concurrent connections, one thread each (default 16)
+ *    -n  requests sent by every connection (default 10000)
+ * Every connection sends random rows (first feature 1 for the bias) one at a time and times each
+ * round trip. At the end the latency percentiles and the total throughput are printed.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "protocol.h"
+
+typedef struct {
+const char *socket_path;
+unsigned int seed;
+size_t requests;
+double *latencies;          // seconds, one per request
+size_t completed;
+pthread_barrier_t *start;
+}ClientThread;
+
+static double elapsed_seconds(const struct timespec *from, const struct timespec *to){
+    return (double)(to->tv_sec - from->tv_sec) + (double)(to->tv_nsec - from->tv_nsec)*1e-9;
+}
+
+static int connect_to(const char *socket_path){
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(strlen(socket_path) >= sizeof(address.sun_path)) return -1;
+    strcpy(address.sun_path, socket_path);
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(connection < 0) return -1;
+    if(connect(connection, (struct sockaddr *)&address, sizeof(address)) != 0){
+        close(connection);
+        return -1;
+    }
+    return connection;
+}
+
+static void *client_thread(void *argument){
+    ClientThread *client = argument;
+    int connection = connect_to(client->socket_path);
+    InferenceHello hello;
+    double *row = NULL, *output = NULL;
+    if(connection >= 0 && inference_read_full(connection, &hello, sizeof(hello)) == 0 && hello.version == INFERENCE_PROTOCOL_VERSION){
+        row = malloc(hello.features*sizeof(double));
+        output = malloc(hello.outputs*sizeof(double));
+    }
+    // Every thread passes the barrier, also after a failure, so that none waits forever
+    pthread_barrier_wait(client->start);
+    if(!row || !output) goto cleanup;
+
+    for(size_t r=0;r<client->requests;r++){
+        row[0] = 1.0;
+        for(size_t j=1;j<hello.features;j++) row[j] = (double)rand_r(&client->seed)/RAND_MAX;
+        struct timespec sent, answered;
+        clock_gettime(CLOCK_MONOTONIC, &sent);
+        if(inference_write_full(connection, row, hello.features*sizeof(double)) != 0) break;
+        if(inference_read_full(connection, output, hello.outputs*sizeof(double)) != 0) break;
+        clock_gettime(CLOCK_MONOTONIC, &answered);
+        client->latencies[client->completed++] = elapsed_seconds(&sent, &answered);
+    }
+
+cleanup:
+    free(row);
+    free(output);
+    if(connection >= 0) close(connection);
+    return NULL;
+}
+
+static int compare_doubles(const void *a, const void *b){
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv){
+    long connections = 16, requests = 10000;
+    int option;
+    while((option = getopt(argc, argv, "c:n:")) != -1){
+        switch(option){
+            case 'c': connections = atol(optarg); break;
+            case 'n': requests = atol(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-c connections] [-n requests] socket_path\n", argv[0]);
+                return 1;
+        }
+    }
+    if(argc - optind != 1 || connections < 1 || requests < 1){
+        fprintf(stderr, "Usage: %s [-c connections] [-n requests] socket_path\n", argv[0]);
+        return 1;
+    }
+
+    size_t total = (size_t)connections*(size_t)requests;
+    ClientThread *clients = calloc((size_t)connections, sizeof(ClientThread));
+    pthread_t *threads = malloc((size_t)connections*sizeof(pthread_t));
+    double *latencies = malloc(total*sizeof(double));
+    if(!clients || !threads || !latencies){
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    // The main thread joins the barrier too and starts the clock once every connection is open
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, (unsigned int)connections + 1);
+    long started = 0;
+    for(;started<connections;started++){
+        clients[started].socket_path = argv[optind];
+        clients[started].seed = (unsigned int)started + 1;
+        clients[started].requests = (size_t)requests;
+        clients[started].latencies = latencies + (size_t)started*(size_t)requests;
+        clients[started].start = &start;
+        if(pthread_create(&threads[started], NULL, client_thread, &clients[started]) != 0){
+            fprintf(stderr, "could not start connection thread %ld\n", started);
+            return 1;
+        }
+    }
+    struct timespec begin, end;
+    pthread_barrier_wait(&start);
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for(long t=0;t<connections;t++) pthread_join(threads[t], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_barrier_destroy(&start);
+
+    // Gather the latencies of all connections at the front of the array
+    size_t completed = 0;
+    for(long t=0;t<connections;t++){
+        memmove(latencies + completed, clients[t].latencies, clients[t].completed*sizeof(double));
+        completed += clients[t].completed;
+    }
+    if(completed == 0){
+        fprintf(stderr, "%s: no request was answered\n", argv[optind]);
+        return 1;
+    }
+    qsort(latencies, completed, sizeof(double), compare_doubles);
+    double seconds = elapsed_seconds(&begin, &end);
+    printf("%zu requests over %ld connections in %.3f s\n", completed, connections, seconds);
+    if(completed < total) printf("%zu requests failed\n", total - completed);
+    printf("throughput %.0f requests/s\n", completed/seconds);
+    printf("latency p50 %.1f us, p99 %.1f us, max %.1f us\n", latencies[(completed*50)/100]*1e6, latencies[(completed*99)/100]*1e6, latencies[completed-1]*1e6);
+
+    free(clients);
+    free(threads);
+    free(latencies);
+    return 0;
+}
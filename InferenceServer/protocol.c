@@ -0,0 +1,48 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "protocol.h"
+
+int inference_read_full(int socket, void *buffer, size_t size){
+    char *position = buffer;
+    while(size > 0){
+        ssize_t count = read(socket, position, size);
+        if(count < 0 && errno == EINTR) continue;
+        if(count <= 0) return -1;
+        position += count;
+        size -= (size_t)count;
+    }
+    return 0;
+}
+
+int inference_write_full(int socket, const void *buffer, size_t size){
+    const char *position = buffer;
+    while(size > 0){
+        ssize_t count = write(socket, position, size);
+        if(count < 0 && errno == EINTR) continue;
+        if(count <= 0) return -1;
+        position += count;
+        size -= (size_t)count;
+    }
+    return 0;
+}
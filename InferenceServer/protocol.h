@@ -0,0 +1,77 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INFERENCE_PROTOCOL_H
+#define INFERENCE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Wire protocol between the inference server and its clients, over a Unix domain stream socket
+ * (all values in the byte order of the machine, client and server always share one):
+ *
+ *   server -> client, once after accept : InferenceHello
+ *   client -> server, per request       : features doubles (one row, bias column included)
+ *   server -> client, per request       : outputs doubles (prediction, probability or the
+ *                                         class probabilities)
+ *
+ * A connection has one request in flight at a time: the client reads the answer before sending
+ * the next row. Concurrency comes from many connections, which the server scores together.
+ */
+
+#define INFERENCE_PROTOCOL_VERSION 1
+
+typedef struct {
+uint32_t version;       // INFERENCE_PROTOCOL_VERSION
+uint32_t model_type;    // ModelType of the served model
+uint32_t features;      // doubles per request
+uint32_t outputs;       // doubles per response
+}InferenceHello;
+
+
+/*
+ * Function: inference_read_full
+ * ----------------------------
+ */
+int inference_read_full(int socket, void *buffer, size_t size);
+/* This function reads exactly `size` bytes from the socket, retrying short reads and interrupted
+ * calls.
+ *
+ * Returns:
+ *    - `0` once all bytes were read.
+ *    - `-1` if the peer closed the connection or reading failed.
+ */
+
+
+/*
+ * Function: inference_write_full
+ * ----------------------------
+ */
+int inference_write_full(int socket, const void *buffer, size_t size);
+/* This function writes exactly `size` bytes to the socket, retrying short writes and interrupted
+ * calls.
+ *
+ * Returns:
+ *    - `0` once all bytes were written.
+ *    - `-1` if writing failed (e.g. the peer closed the connection).
+ */
+
+#endif // INFERENCE_PROTOCOL_H
@@ -0,0 +1,332 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Micro-batching inference server for CLearn models.
+ * Usage: ./server [-t type] [-b max_batch] [-w max_wait_us] [-f] model_file socket_path
+ *    -t  model type in the file: mlr, logistic or softmax (default mlr)
+ *    -b  most rows scored together (default 64)
+ *    -w  microseconds the oldest waiting request may be held back to fill a batch (default 200,
+ *        0 scores whatever is waiting at once)
+ *    -f  use the fast sigmoid kernel for logistic models
+ * The model file (see ModelIO) is mapped, not read. Every connection is served by its own thread,
+ * which queues its rows; a single batching thread takes up to max_batch queued rows, copies them
+ * into one matrix and scores them with one matrix-matrix product. The server runs until it gets
+ * SIGINT or SIGTERM and then prints how many batches it scored.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_matrix.h>
+
+#include "protocol.h"
+#include "../ModelIO/model_io.h"
+#include "../LogisticRegression/logistic_regression.h"
+#include "../SoftmaxRegression/softmax_regression.h"
+
+typedef struct Request {
+const double *row;          // the features, owned by the connection thread
+double *output;             // receives the outputs
+struct timespec arrival;    // when the row was queued
+int done;
+pthread_cond_t answered;    // signalled by the batching thread once output is filled
+struct Request *next;
+}Request;
+
+typedef struct {
+ModelType type;
+gsl_matrix *weight_set;     // features x outputs, a view of the mapped model
+size_t features, outputs;
+size_t max_batch;
+long max_wait_us;
+SigmoidAccuracy accuracy;
+
+pthread_mutex_t lock;       // guards everything below
+pthread_cond_t queued;      // signalled when the queue becomes non empty or reaches max_batch
+Request *head, *tail;
+size_t length;
+unsigned long long batches, rows;
+}Server;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop(int signal_number){
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+static void add_microseconds(struct timespec *time, long microseconds){
+    time->tv_sec += microseconds / 1000000;
+    time->tv_nsec += (microseconds % 1000000) * 1000;
+    if(time->tv_nsec >= 1000000000){
+        time->tv_sec++;
+        time->tv_nsec -= 1000000000;
+    }
+}
+
+/*
+Scores the first `count` rows of x_batch into output_batch (count x outputs):
+one dgemm X_B * W, then the model's link function over the block.
+ */
+static void score_batch(Server *server, gsl_matrix *x_batch, gsl_matrix *output_batch, size_t count){
+    gsl_matrix_view x_view = gsl_matrix_submatrix(x_batch, 0, 0, count, server->features);
+    gsl_matrix_view output_view = gsl_matrix_submatrix(output_batch, 0, 0, count, server->outputs);
+    if(server->type == MODEL_SOFTMAX){
+        // Same dgemm followed by the fused row softmax of the softmax module
+        softmax_regression_predict(&output_view.matrix, NULL, server->weight_set, &x_view.matrix);
+        return;
+    }
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &x_view.matrix, server->weight_set, 0.0, &output_view.matrix);
+    if(server->type == MODEL_LOGISTIC) sigmoid_vector(output_batch->data, output_batch->data, count, server->accuracy);
+}
+
+static void *batching_thread(void *argument){
+    Server *server = argument;
+    gsl_matrix *x_batch = gsl_matrix_alloc(server->max_batch, server->features);
+    gsl_matrix *output_batch = gsl_matrix_alloc(server->max_batch, server->outputs);
+    Request **batch = malloc(server->max_batch*sizeof(Request *));
+    if(!x_batch || !output_batch || !batch){
+        fprintf(stderr, "server: out of memory for batches of %zu rows\n", server->max_batch);
+        exit(1);
+    }
+
+    pthread_mutex_lock(&server->lock);
+    for(;;){
+        while(server->length == 0) pthread_cond_wait(&server->queued, &server->lock);
+        // Hold the oldest request back until the batch is full or it has waited max_wait_us
+        struct timespec deadline = server->head->arrival;
+        add_microseconds(&deadline, server->max_wait_us);
+        while(server->length < server->max_batch){
+            if(pthread_cond_timedwait(&server->queued, &server->lock, &deadline) == ETIMEDOUT) break;
+        }
+
+        size_t count = 0;
+        while(count < server->max_batch && server->head){
+            batch[count++] = server->head;
+            server->head = server->head->next;
+        }
+        if(!server->head) server->tail = NULL;
+        server->length -= count;
+        pthread_mutex_unlock(&server->lock);
+
+        // The connection threads are blocked until answered, their rows cannot change meanwhile
+        for(size_t i=0;i<count;i++){
+            memcpy(x_batch->data + i*x_batch->tda, batch[i]->row, server->features*sizeof(double));
+        }
+        score_batch(server, x_batch, output_batch, count);
+
+        pthread_mutex_lock(&server->lock);
+        for(size_t i=0;i<count;i++){
+            memcpy(batch[i]->output, output_batch->data + i*output_batch->tda, server->outputs*sizeof(double));
+            batch[i]->done = 1;
+            pthread_cond_signal(&batch[i]->answered);
+        }
+        server->batches++;
+        server->rows += count;
+    }
+    return NULL;
+}
+
+typedef struct {
+Server *server;
+int socket;
+}Connection;
+
+static void *connection_thread(void *argument){
+    Connection *connection = argument;
+    Server *server = connection->server;
+    int socket = connection->socket;
+    free(connection);
+
+    double *row = malloc(server->features*sizeof(double));
+    double *output = malloc(server->outputs*sizeof(double));
+    InferenceHello hello = {INFERENCE_PROTOCOL_VERSION, (uint32_t)server->type, (uint32_t)server->features, (uint32_t)server->outputs};
+    Request request;
+    request.row = row;
+    request.output = output;
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&request.answered, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    if(row && output && inference_write_full(socket, &hello, sizeof(hello)) == 0){
+        while(inference_read_full(socket, row, server->features*sizeof(double)) == 0){
+            request.done = 0;
+            request.next = NULL;
+            pthread_mutex_lock(&server->lock);
+            clock_gettime(CLOCK_MONOTONIC, &request.arrival);
+            if(server->tail) server->tail->next = &request;
+            else server->head = &request;
+            server->tail = &request;
+            server->length++;
+            // The batching thread only cares about the first row and a full batch
+            if(server->length == 1 || server->length == server->max_batch) pthread_cond_signal(&server->queued);
+            while(!request.done) pthread_cond_wait(&request.answered, &server->lock);
+            pthread_mutex_unlock(&server->lock);
+            if(inference_write_full(socket, output, server->outputs*sizeof(double)) != 0) break;
+        }
+    }
+    pthread_cond_destroy(&request.answered);
+    free(row);
+    free(output);
+    close(socket);
+    return NULL;
+}
+
+static void usage(const char *program){
+    fprintf(stderr, "Usage: %s [-t mlr|logistic|softmax] [-b max_batch] [-w max_wait_us] [-f] model_file socket_path\n", program);
+}
+
+int main(int argc, char **argv){
+    ModelType type = MODEL_MLR;
+    long max_batch = 64, max_wait_us = 200;
+    SigmoidAccuracy accuracy = SIGMOID_EXACT;
+    int option;
+    while((option = getopt(argc, argv, "t:b:w:f")) != -1){
+        switch(option){
+            case 't':
+                if(strcmp(optarg, "mlr") == 0) type = MODEL_MLR;
+                else if(strcmp(optarg, "logistic") == 0) type = MODEL_LOGISTIC;
+                else if(strcmp(optarg, "softmax") == 0) type = MODEL_SOFTMAX;
+                else{
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'b': max_batch = atol(optarg); break;
+            case 'w': max_wait_us = atol(optarg); break;
+            case 'f': accuracy = SIGMOID_FAST; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if(argc - optind != 2 || max_batch < 1 || max_wait_us < 0){
+        usage(argv[0]);
+        return 1;
+    }
+    const char *model_path = argv[optind], *socket_path = argv[optind+1];
+
+    MappedModel model;
+    unsigned int status = model_map(&model, model_path, type, 1);
+    if(status != 0){
+        fprintf(stderr, "%s: %s\n", model_path, (status == 1) ? "could not be mapped" : "not a valid model file of the requested type");
+        return 1;
+    }
+
+    Server server;
+    server.type = type;
+    server.weight_set = &model.weight_matrix.matrix;
+    server.features = server.weight_set->size1;
+    server.outputs = server.weight_set->size2;
+    server.max_batch = (size_t)max_batch;
+    server.max_wait_us = max_wait_us;
+    server.accuracy = accuracy;
+    server.head = server.tail = NULL;
+    server.length = 0;
+    server.batches = server.rows = 0;
+    pthread_mutex_init(&server.lock, NULL);
+    // Deadlines are measured on the monotonic clock, immune to changes of the wall clock
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&server.queued, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(strlen(socket_path) >= sizeof(address.sun_path)){
+        fprintf(stderr, "%s: socket path too long\n", socket_path);
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0){
+        perror("socket");
+        return 1;
+    }
+    unlink(socket_path);
+    if(bind(listener, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listener, 128) != 0){
+        perror(socket_path);
+        return 1;
+    }
+
+    // No SA_RESTART, so that accept returns when a stop signal arrives
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    // A client that disconnects mid answer must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_t batcher;
+    if(pthread_create(&batcher, NULL, batching_thread, &server) != 0){
+        fprintf(stderr, "could not start the batching thread\n");
+        return 1;
+    }
+    pthread_detach(batcher);
+    printf("Serving %zu feature(s) -> %zu output(s) on %s (batches of up to %zu rows, %ld us wait)\n", server.features, server.outputs, socket_path, server.max_batch, server.max_wait_us);
+    fflush(stdout);
+
+    while(!stop_requested){
+        int socket = accept(listener, NULL, NULL);
+        if(socket < 0){
+            if(errno == EINTR || errno == ECONNABORTED) continue;
+            perror("accept");
+            break;
+        }
+        Connection *connection = malloc(sizeof(Connection));
+        pthread_t thread;
+        if(!connection){
+            close(socket);
+            continue;
+        }
+        connection->server = &server;
+        connection->socket = socket;
+        if(pthread_create(&thread, NULL, connection_thread, connection) != 0){
+            free(connection);
+            close(socket);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    close(listener);
+    unlink(socket_path);
+    pthread_mutex_lock(&server.lock);
+    printf("Scored %llu rows in %llu batches (%.2f rows per batch)\n", server.rows, server.batches, server.batches ? (double)server.rows/server.batches : 0.0);
+    pthread_mutex_unlock(&server.lock);
+    // Connection and batching threads may still be running: exiting ends them and releases the mapping
+    return 0;
+}
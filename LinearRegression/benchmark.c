@@ -0,0 +1,157 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput of the simple linear regression entry points on synthetic data.
+ * Usage: ./benchmark [-j] [-q] [-r repetitions]
+ *    -j  print the results as JSON, for tracking regressions between versions
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case, the median is reported (default 5)
+ * The data is y = 2.5x + 3 with a little noise, at 10^3, 10^5 and 10^7 points. The online banks 
+ * treat the same points as ticks of 1000 series. See Benchmark/README.md for how the rates are 
+ * defined.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "linear_regression.h"
+#include "../Benchmark/benchmark_report.h"
+
+// Series of the online bank cases, the points are fed as number_of_data / BENCHMARK_SERIES ticks
+#define BENCHMARK_SERIES 1000
+// Ticks in the window of the windowed bank case
+#define BENCHMARK_WINDOW 100
+
+typedef struct {
+double *x_data;
+double *y_data;
+double *y_new;
+int number_of_data;
+unsigned int number_of_threads;
+LinearRegressionResult result_set;
+LinearRegressionBank *decay_bank;
+LinearRegressionBank *window_bank;
+}LinearCase;
+
+static void run_train(void *context){
+    LinearCase *c = context;
+    linear_regression_train(&c->result_set, c->x_data, c->y_data, c->number_of_data);
+}
+
+static void run_train_parallel(void *context){
+    LinearCase *c = context;
+    linear_regression_train_parallel(&c->result_set, c->x_data, c->y_data, c->number_of_data, c->number_of_threads);
+}
+
+static void run_predict(void *context){
+    LinearCase *c = context;
+    for(int i=0;i<c->number_of_data;i++) c->y_new[i] = linear_regression_predict(c->result_set, c->x_data[i]);
+}
+
+static void run_predict_batch(void *context){
+    LinearCase *c = context;
+    linear_regression_predict_batch(&c->result_set, c->x_data, c->y_new, c->number_of_data);
+}
+
+static void run_bank_decay(void *context){
+    LinearCase *c = context;
+    linear_regression_bank_update(c->decay_bank, c->x_data, c->y_data, (size_t)c->number_of_data/BENCHMARK_SERIES);
+}
+
+static void run_bank_window(void *context){
+    LinearCase *c = context;
+    linear_regression_bank_update(c->window_bank, c->x_data, c->y_data, (size_t)c->number_of_data/BENCHMARK_SERIES);
+}
+
+int main(int argc, char **argv){
+    BenchmarkReport report;
+    if(benchmark_parse_arguments(&report, "linear_regression", argc, argv) != 0) return 1;
+    int sizes[] = {1000, 100000, 10000000};
+    size_t number_of_sizes = report.quick ? 2 : 3;
+
+    benchmark_begin(&report);
+    for(size_t s=0;s<number_of_sizes;s++){
+        LinearCase c;
+        c.number_of_data = sizes[s];
+        c.number_of_threads = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+        c.x_data = malloc((size_t)c.number_of_data*sizeof(double));
+        c.y_data = malloc((size_t)c.number_of_data*sizeof(double));
+        c.y_new = malloc((size_t)c.number_of_data*sizeof(double));
+        c.decay_bank = linear_regression_bank_alloc_decay(BENCHMARK_SERIES, 50);
+        c.window_bank = linear_regression_bank_alloc_window(BENCHMARK_SERIES, BENCHMARK_WINDOW);
+        if(!c.x_data||!c.y_data||!c.y_new||!c.decay_bank||!c.window_bank){
+            fprintf(stderr, "Could not allocate %d points\n", c.number_of_data);
+            return 1;
+        }
+        srand(42);
+        for(int i=0;i<c.number_of_data;i++){
+            c.x_data[i] = 100.0*rand()/RAND_MAX;
+            c.y_data[i] = 2.5*c.x_data[i] + 3 + ((double)rand()/RAND_MAX - 0.5);
+        }
+        double m = c.number_of_data;
+
+        // Train: 2 loads per point; sums of x, y, xy and x^2 are 6 operations
+        BenchmarkResult result = {"linear_regression_train", (size_t)c.number_of_data, 1, 1, 0, 6*m, 16*m};
+        result.seconds = benchmark_time(run_train, &c, report.repetitions);
+        benchmark_print(&report, &result);
+
+        // Every slice is summarised in two passes: means, then centered sums (8 operations)
+        result.function = "linear_regression_train_parallel";
+        result.flops = 8*m;
+        result.bytes = 32*m;
+        result.seconds = benchmark_time(run_train_parallel, &c, report.repetitions);
+        benchmark_print(&report, &result);
+
+        // Predict: load x, store y, one multiply and one add
+        result.function = "linear_regression_predict";
+        result.flops = 2*m;
+        result.bytes = 16*m;
+        result.seconds = benchmark_time(run_predict, &c, report.repetitions);
+        benchmark_print(&report, &result);
+
+        result.function = "linear_regression_predict_batch";
+        result.seconds = benchmark_time(run_predict_batch, &c, report.repetitions);
+        benchmark_print(&report, &result);
+
+        // Online banks, one tick of all series per row: the decayed update reads x, y and 4 state 
+        // values and writes the state (10 operations); the window replacement also reads the 
+        // leaving sample, writes the new one to the ring (15 operations) and rebuilds every window
+        result.function = "linear_regression_bank_update (decay)";
+        result.flops = 10*m;
+        result.bytes = 80*m;
+        result.seconds = benchmark_time(run_bank_decay, &c, report.repetitions);
+        benchmark_print(&report, &result);
+        result.function = "linear_regression_bank_update (window)";
+        result.flops = 15*m + 8*m;
+        result.bytes = 112*m + 32*m;
+        result.seconds = benchmark_time(run_bank_window, &c, report.repetitions);
+        benchmark_print(&report, &result);
+
+        free(c.x_data);
+        free(c.y_data);
+        free(c.y_new);
+        linear_regression_bank_free(c.decay_bank);
+        linear_regression_bank_free(c.window_bank);
+    }
+    benchmark_end(&report);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Scaling benchmark for linear_regression_train_parallel.
+ * Usage: ./benchmark_parallel [number_of_data] [max_threads]
+ * Runs the training with 1, 2, 4, ... max_threads workers on the same synthetic data
+ * and prints the time, throughput and speedup over the single threaded run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "linear_regression.h"
+
+static double seconds_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+int main(int argc, char **argv){
+    int number_of_data = (argc > 1) ? atoi(argv[1]) : 20000000;
+    long max_threads = (argc > 2) ? atol(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if(number_of_data < 2 || max_threads < 1){
+        printf("Usage: %s [number_of_data >= 2] [max_threads >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    double *x_data = malloc((size_t)number_of_data*sizeof(double));
+    double *y_data = malloc((size_t)number_of_data*sizeof(double));
+    if(!x_data||!y_data){
+        printf("Could not allocate %d points\n", number_of_data);
+        free(x_data);
+        free(y_data);
+        return 1;
+    }
+
+    // y = 2.5x + 3 with a little deterministic noise
+    srand(42);
+    for(int i=0;i<number_of_data;i++){
+        x_data[i] = 1000.0 + (double)rand()/RAND_MAX;
+        y_data[i] = 2.5*x_data[i] + 3.0 + ((double)rand()/RAND_MAX - 0.5)*0.01;
+    }
+
+    // Warm up caches and page tables once before measuring
+    LinearRegressionResult result;
+    linear_regression_train(&result, x_data, y_data, number_of_data);
+    double start = seconds_now();
+    linear_regression_train(&result, x_data, y_data, number_of_data);
+    double serial_time = seconds_now() - start;
+    printf("points: %d\n", number_of_data);
+    printf("%-10s %12s %14s %9s %12s %12s\n", "threads", "time (s)", "points/s", "speedup", "slope", "intercept");
+    printf("%-10s %12.4f %14.3e %9s %12.6f %12.6f\n", "serial", serial_time, number_of_data/serial_time, "-", result.slope, result.intercept);
+
+    double single_thread_time = 0;
+    for(long threads=1;;threads*=2){
+        if(threads > max_threads) threads = max_threads;
+        // Best of three runs to hide scheduling noise
+        double best = 0;
+        for(int run=0;run<3;run++){
+            start = seconds_now();
+            if(linear_regression_train_parallel(&result, x_data, y_data, number_of_data, (unsigned int)threads) != 0){
+                printf("Training failed with %ld threads\n", threads);
+                free(x_data);
+                free(y_data);
+                return 1;
+            }
+            double elapsed = seconds_now() - start;
+            if(run == 0 || elapsed < best) best = elapsed;
+        }
+        if(threads == 1) single_thread_time = best;
+        printf("%-10ld %12.4f %14.3e %9.2f %12.6f %12.6f\n", threads, best, number_of_data/best, single_thread_time/best, result.slope, result.intercept);
+        if(threads == max_threads) break;
+    }
+
+    free(x_data);
+    free(y_data);
+    return 0;
+}
@@ -19,8 +19,27 @@
  */
 
 
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <pthread.h>
+
 #include "linear_regression.h"
 
+// SIMD kernels are only built for x86 with GCC/Clang, which can compile them per function and check the CPU at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LINEAR_REGRESSION_X86_DISPATCH
+#endif
+
+// Work description for one thread of linear_regression_train_parallel
+typedef struct {
+    double *x_data;
+    double *y_data;
+    int number_of_data;
+    LinearRegressionAccumulator accumulator;
+}LinearRegressionSlice;
+
 void linear_regression_train(LinearRegressionResult *result_set, double *x_data, double *y_data, int number_of_data){
     // To calculate the slope the formula is slope=(mean(xy)-mean(x)mean(y))/(mean(x^2)-mean(x)^2)
     double slope = 0,
@@ -57,3 +76,401 @@ double linear_regression_predict(LinearRegressionResult result_set, double x_new
     return (result_set.slope*x_new + result_set.intercept);
 }
 
+static void predict_batch_scalar(double slope, double intercept, double *x_new, double *y_new, int number_of_data){
+    for(int i=0;i<number_of_data;i++){
+        y_new[i] = slope*x_new[i] + intercept;
+    }
+}
+
+#ifdef LINEAR_REGRESSION_X86_DISPATCH
+__attribute__((target("avx2,fma")))
+static void predict_batch_avx2(double slope, double intercept, double *x_new, double *y_new, int number_of_data){
+    __m256d slope_vector = _mm256_set1_pd(slope);
+    __m256d intercept_vector = _mm256_set1_pd(intercept);
+    int i = 0;
+    // Two vectors per iteration to keep both load ports busy
+    for(;i+8<=number_of_data;i+=8){
+        __m256d x0 = _mm256_loadu_pd(x_new+i);
+        __m256d x1 = _mm256_loadu_pd(x_new+i+4);
+        _mm256_storeu_pd(y_new+i, _mm256_fmadd_pd(slope_vector, x0, intercept_vector));
+        _mm256_storeu_pd(y_new+i+4, _mm256_fmadd_pd(slope_vector, x1, intercept_vector));
+    }
+    for(;i+4<=number_of_data;i+=4){
+        __m256d x0 = _mm256_loadu_pd(x_new+i);
+        _mm256_storeu_pd(y_new+i, _mm256_fmadd_pd(slope_vector, x0, intercept_vector));
+    }
+    predict_batch_scalar(slope, intercept, x_new+i, y_new+i, number_of_data-i);
+}
+
+__attribute__((target("avx512f")))
+static void predict_batch_avx512(double slope, double intercept, double *x_new, double *y_new, int number_of_data){
+    __m512d slope_vector = _mm512_set1_pd(slope);
+    __m512d intercept_vector = _mm512_set1_pd(intercept);
+    int i = 0;
+    for(;i+16<=number_of_data;i+=16){
+        __m512d x0 = _mm512_loadu_pd(x_new+i);
+        __m512d x1 = _mm512_loadu_pd(x_new+i+8);
+        _mm512_storeu_pd(y_new+i, _mm512_fmadd_pd(slope_vector, x0, intercept_vector));
+        _mm512_storeu_pd(y_new+i+8, _mm512_fmadd_pd(slope_vector, x1, intercept_vector));
+    }
+    // Remaining 0-15 points with masked loads and stores
+    while(i<number_of_data){
+        int left = number_of_data-i;
+        __mmask8 mask = (left >= 8) ? (__mmask8)0xFF : (__mmask8)((1u << left) - 1);
+        __m512d x0 = _mm512_maskz_loadu_pd(mask, x_new+i);
+        _mm512_mask_storeu_pd(y_new+i, mask, _mm512_fmadd_pd(slope_vector, x0, intercept_vector));
+        i += 8;
+    }
+}
+#endif
+
+void linear_regression_predict_batch(LinearRegressionResult *result_set, double *x_new, double *y_new, int number_of_data){
+    if(number_of_data <= 0) return;
+#ifdef LINEAR_REGRESSION_X86_DISPATCH
+    // Pick the widest instruction set the running CPU supports
+    if(__builtin_cpu_supports("avx512f")){
+        predict_batch_avx512(result_set->slope, result_set->intercept, x_new, y_new, number_of_data);
+        return;
+    }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        predict_batch_avx2(result_set->slope, result_set->intercept, x_new, y_new, number_of_data);
+        return;
+    }
+#endif
+    predict_batch_scalar(result_set->slope, result_set->intercept, x_new, y_new, number_of_data);
+}
+
+void linear_regression_accumulator_init(LinearRegressionAccumulator *accumulator){
+    accumulator->number_of_data = 0;
+    accumulator->x_mean = 0;
+    accumulator->y_mean = 0;
+    accumulator->x_deviation_sum = 0;
+    accumulator->xy_deviation_sum = 0;
+}
+
+void linear_regression_accumulator_merge(LinearRegressionAccumulator *destination, LinearRegressionAccumulator *source){
+    if(source->number_of_data == 0) return;
+    if(destination->number_of_data == 0){
+        *destination = *source;
+        return;
+    }
+    double n_a = (double)destination->number_of_data,
+           n_b = (double)source->number_of_data,
+           n = n_a + n_b,
+           x_delta = source->x_mean - destination->x_mean,
+           y_delta = source->y_mean - destination->y_mean;
+
+    // Pairwise update, the correction term accounts for the shift between the two means
+    destination->x_deviation_sum += source->x_deviation_sum + x_delta*x_delta*(n_a*n_b/n);
+    destination->xy_deviation_sum += source->xy_deviation_sum + x_delta*y_delta*(n_a*n_b/n);
+    destination->x_mean += x_delta*(n_b/n);
+    destination->y_mean += y_delta*(n_b/n);
+    destination->number_of_data += source->number_of_data;
+}
+
+void linear_regression_accumulator_update(LinearRegressionAccumulator *accumulator, double *x_data, double *y_data, int number_of_data){
+    if(number_of_data <= 0) return;
+
+    // Summarise the chunk on its own with two passes (means first, then centered sums)
+    LinearRegressionAccumulator chunk;
+    double x_mean = 0,
+           y_mean = 0,
+           x_deviation_sum = 0,
+           xy_deviation_sum = 0;
+
+    for(int i=0;i<number_of_data;i++){
+        x_mean+=x_data[i];
+        y_mean+=y_data[i];
+    }
+    x_mean /= number_of_data;
+    y_mean /= number_of_data;
+
+    for(int i=0;i<number_of_data;i++){
+        double x_deviation = x_data[i]-x_mean;
+        x_deviation_sum+=(x_deviation*x_deviation);
+        xy_deviation_sum+=(x_deviation*(y_data[i]-y_mean));
+    }
+
+    chunk.number_of_data = (unsigned long long)number_of_data;
+    chunk.x_mean = x_mean;
+    chunk.y_mean = y_mean;
+    chunk.x_deviation_sum = x_deviation_sum;
+    chunk.xy_deviation_sum = xy_deviation_sum;
+
+    linear_regression_accumulator_merge(accumulator, &chunk);
+}
+
+unsigned int linear_regression_accumulator_finalize(LinearRegressionAccumulator *accumulator, LinearRegressionResult *result_set){
+    // slope is undefined for a single point or a vertical set of points
+    if(accumulator->number_of_data < 2 || accumulator->x_deviation_sum == 0) return 2; // 2 is for arithmatic error
+
+    double slope = accumulator->xy_deviation_sum/accumulator->x_deviation_sum;
+    result_set->slope = slope;
+    result_set->intercept = accumulator->y_mean-(slope*accumulator->x_mean);
+    return 0; //No errors
+}
+
+static void *linear_regression_slice_worker(void *argument){
+    LinearRegressionSlice *slice = (LinearRegressionSlice *)argument;
+    linear_regression_accumulator_init(&slice->accumulator);
+    linear_regression_accumulator_update(&slice->accumulator, slice->x_data, slice->y_data, slice->number_of_data);
+    return NULL;
+}
+
+unsigned int linear_regression_train_parallel(LinearRegressionResult *result_set, double *x_data, double *y_data, int number_of_data, unsigned int number_of_threads){
+    if(number_of_data < 2) return 2; // 2 is for arithmatic error
+    if(number_of_threads == 0) number_of_threads = 1;
+    if(number_of_threads > (unsigned int)number_of_data) number_of_threads = (unsigned int)number_of_data;
+
+    LinearRegressionSlice *slices = malloc(number_of_threads*sizeof(LinearRegressionSlice));
+    pthread_t *threads = malloc(number_of_threads*sizeof(pthread_t));
+    if(!slices||!threads){
+        free(slices);
+        free(threads);
+        return 1; // 1 is for system error
+    }
+
+    // Contiguous slices, the first (number_of_data % number_of_threads) slices get one extra point
+    int base_size = number_of_data/(int)number_of_threads,
+        remainder = number_of_data%(int)number_of_threads,
+        offset = 0;
+    for(unsigned int t=0;t<number_of_threads;t++){
+        int size = base_size + ((int)t < remainder ? 1 : 0);
+        slices[t].x_data = x_data + offset;
+        slices[t].y_data = y_data + offset;
+        slices[t].number_of_data = size;
+        offset += size;
+    }
+
+    // Slice 0 is done by the calling thread while the workers run the rest
+    unsigned int started = 1;
+    for(;started<number_of_threads;started++){
+        if(pthread_create(&threads[started], NULL, linear_regression_slice_worker, &slices[started]) != 0) break;
+    }
+    linear_regression_slice_worker(&slices[0]);
+    for(unsigned int t=1;t<started;t++){
+        pthread_join(threads[t], NULL);
+    }
+    if(started != number_of_threads){
+        free(slices);
+        free(threads);
+        return 1;
+    }
+
+    // Merge in slice order so the result only depends on the thread count
+    LinearRegressionAccumulator total;
+    linear_regression_accumulator_init(&total);
+    for(unsigned int t=0;t<number_of_threads;t++){
+        linear_regression_accumulator_merge(&total, &slices[t].accumulator);
+    }
+
+    free(slices);
+    free(threads);
+    return linear_regression_accumulator_finalize(&total, result_set);
+}
+
+// Allocates the bank and its per series arrays, as one block so the four arrays are adjacent
+static LinearRegressionBank *linear_regression_bank_alloc(size_t number_of_series, size_t window, double decay){
+    LinearRegressionBank *bank = calloc(1, sizeof(LinearRegressionBank));
+    if(!bank)return NULL;
+    bank->number_of_series = number_of_series;
+    bank->window = window;
+    bank->decay = decay;
+    bank->x_mean = calloc(4*number_of_series, sizeof(double));
+    if(!bank->x_mean){
+        linear_regression_bank_free(bank);
+        return NULL;
+    }
+    bank->y_mean = bank->x_mean + number_of_series;
+    bank->x_deviation_sum = bank->y_mean + number_of_series;
+    bank->xy_deviation_sum = bank->x_deviation_sum + number_of_series;
+    if(window > 0){
+        bank->x_history = malloc(2*window*number_of_series*sizeof(double));
+        if(!bank->x_history){
+            linear_regression_bank_free(bank);
+            return NULL;
+        }
+        bank->y_history = bank->x_history + window*number_of_series;
+    }
+    return bank;
+}
+
+LinearRegressionBank *linear_regression_bank_alloc_decay(size_t number_of_series, double half_life){
+    if(number_of_series == 0 || !(half_life > 0)) return NULL;
+    return linear_regression_bank_alloc(number_of_series, 0, pow(0.5, 1.0/half_life));
+}
+
+LinearRegressionBank *linear_regression_bank_alloc_window(size_t number_of_series, size_t window){
+    if(number_of_series == 0 || window < 2) return NULL;
+    return linear_regression_bank_alloc(number_of_series, window, 1.0);
+}
+
+void linear_regression_bank_free(LinearRegressionBank *bank){
+    if(!bank)return;
+    free(bank->x_mean);
+    free(bank->x_history);
+    free(bank);
+}
+
+/*
+Adds one sample per series from index `from` on, after scaling the old sums by decay.
+inverse_weight is 1/W for the total weight W including the new sample
+ */
+static void bank_add_scalar(LinearRegressionBank *bank, double *x_data, double *y_data, double decay, double inverse_weight, size_t from){
+    for(size_t s=from;s<bank->number_of_series;s++){
+        double x_delta = x_data[s] - bank->x_mean[s];
+        double x_mean = bank->x_mean[s] + x_delta*inverse_weight;
+        double y_mean = bank->y_mean[s] + (y_data[s] - bank->y_mean[s])*inverse_weight;
+        bank->x_deviation_sum[s] = decay*bank->x_deviation_sum[s] + x_delta*(x_data[s] - x_mean);
+        bank->xy_deviation_sum[s] = decay*bank->xy_deviation_sum[s] + x_delta*(y_data[s] - y_mean);
+        bank->x_mean[s] = x_mean;
+        bank->y_mean[s] = y_mean;
+    }
+}
+
+// Replaces the oldest sample of every series (x_old, y_old) by the new one in a full window of weight 1/inverse_weight
+static void bank_replace_scalar(LinearRegressionBank *bank, double *x_data, double *y_data, double *x_old, double *y_old, double inverse_weight, size_t from){
+    for(size_t s=from;s<bank->number_of_series;s++){
+        double x_mean = bank->x_mean[s] + (x_data[s] - x_old[s])*inverse_weight;
+        double y_mean = bank->y_mean[s] + (y_data[s] - y_old[s])*inverse_weight;
+        double new_delta = x_data[s] - bank->x_mean[s], old_delta = x_old[s] - bank->x_mean[s];
+        bank->x_deviation_sum[s] += new_delta*(x_data[s] - x_mean) - old_delta*(x_old[s] - x_mean);
+        bank->xy_deviation_sum[s] += new_delta*(y_data[s] - y_mean) - old_delta*(y_old[s] - y_mean);
+        bank->x_mean[s] = x_mean;
+        bank->y_mean[s] = y_mean;
+    }
+}
+
+#ifdef LINEAR_REGRESSION_X86_DISPATCH
+__attribute__((target("avx2,fma")))
+static void bank_add_avx2(LinearRegressionBank *bank, double *x_data, double *y_data, double decay, double inverse_weight){
+    __m256d decay_vector = _mm256_set1_pd(decay);
+    __m256d inverse_vector = _mm256_set1_pd(inverse_weight);
+    size_t s = 0;
+    for(;s+4<=bank->number_of_series;s+=4){
+        __m256d x = _mm256_loadu_pd(x_data+s), y = _mm256_loadu_pd(y_data+s);
+        __m256d x_mean = _mm256_loadu_pd(bank->x_mean+s), y_mean = _mm256_loadu_pd(bank->y_mean+s);
+        __m256d x_delta = _mm256_sub_pd(x, x_mean);
+        x_mean = _mm256_fmadd_pd(x_delta, inverse_vector, x_mean);
+        y_mean = _mm256_fmadd_pd(_mm256_sub_pd(y, y_mean), inverse_vector, y_mean);
+        __m256d x_deviation = _mm256_mul_pd(x_delta, _mm256_sub_pd(x, x_mean));
+        __m256d xy_deviation = _mm256_mul_pd(x_delta, _mm256_sub_pd(y, y_mean));
+        _mm256_storeu_pd(bank->x_deviation_sum+s, _mm256_fmadd_pd(decay_vector, _mm256_loadu_pd(bank->x_deviation_sum+s), x_deviation));
+        _mm256_storeu_pd(bank->xy_deviation_sum+s, _mm256_fmadd_pd(decay_vector, _mm256_loadu_pd(bank->xy_deviation_sum+s), xy_deviation));
+        _mm256_storeu_pd(bank->x_mean+s, x_mean);
+        _mm256_storeu_pd(bank->y_mean+s, y_mean);
+    }
+    bank_add_scalar(bank, x_data, y_data, decay, inverse_weight, s);
+}
+
+__attribute__((target("avx2,fma")))
+static void bank_replace_avx2(LinearRegressionBank *bank, double *x_data, double *y_data, double *x_old, double *y_old, double inverse_weight){
+    __m256d inverse_vector = _mm256_set1_pd(inverse_weight);
+    size_t s = 0;
+    for(;s+4<=bank->number_of_series;s+=4){
+        __m256d x = _mm256_loadu_pd(x_data+s), y = _mm256_loadu_pd(y_data+s);
+        __m256d x_leaving = _mm256_loadu_pd(x_old+s), y_leaving = _mm256_loadu_pd(y_old+s);
+        __m256d old_x_mean = _mm256_loadu_pd(bank->x_mean+s);
+        __m256d x_mean = _mm256_fmadd_pd(_mm256_sub_pd(x, x_leaving), inverse_vector, old_x_mean);
+        __m256d y_mean = _mm256_fmadd_pd(_mm256_sub_pd(y, y_leaving), inverse_vector, _mm256_loadu_pd(bank->y_mean+s));
+        __m256d new_delta = _mm256_sub_pd(x, old_x_mean), old_delta = _mm256_sub_pd(x_leaving, old_x_mean);
+        __m256d x_deviation = _mm256_fmsub_pd(new_delta, _mm256_sub_pd(x, x_mean), _mm256_mul_pd(old_delta, _mm256_sub_pd(x_leaving, x_mean)));
+        __m256d xy_deviation = _mm256_fmsub_pd(new_delta, _mm256_sub_pd(y, y_mean), _mm256_mul_pd(old_delta, _mm256_sub_pd(y_leaving, y_mean)));
+        _mm256_storeu_pd(bank->x_deviation_sum+s, _mm256_add_pd(_mm256_loadu_pd(bank->x_deviation_sum+s), x_deviation));
+        _mm256_storeu_pd(bank->xy_deviation_sum+s, _mm256_add_pd(_mm256_loadu_pd(bank->xy_deviation_sum+s), xy_deviation));
+        _mm256_storeu_pd(bank->x_mean+s, x_mean);
+        _mm256_storeu_pd(bank->y_mean+s, y_mean);
+    }
+    bank_replace_scalar(bank, x_data, y_data, x_old, y_old, inverse_weight, s);
+}
+#endif
+
+static void bank_add(LinearRegressionBank *bank, double *x_data, double *y_data, double decay, double inverse_weight){
+#ifdef LINEAR_REGRESSION_X86_DISPATCH
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        bank_add_avx2(bank, x_data, y_data, decay, inverse_weight);
+        return;
+    }
+#endif
+    bank_add_scalar(bank, x_data, y_data, decay, inverse_weight, 0);
+}
+
+static void bank_replace(LinearRegressionBank *bank, double *x_data, double *y_data, double *x_old, double *y_old, double inverse_weight){
+#ifdef LINEAR_REGRESSION_X86_DISPATCH
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        bank_replace_avx2(bank, x_data, y_data, x_old, y_old, inverse_weight);
+        return;
+    }
+#endif
+    bank_replace_scalar(bank, x_data, y_data, x_old, y_old, inverse_weight, 0);
+}
+
+/*
+Recomputes the means and centered sums of a full window from the ring with two passes. The 
+rounding of the running means (relative to the data, not to its spread) is otherwise multiplied 
+by every later x_new - x_old, so it is dropped once per window
+ */
+static void bank_rebuild(LinearRegressionBank *bank){
+    size_t n = bank->number_of_series;
+    for(size_t s=0;s<n;s++){
+        bank->x_mean[s] = 0;
+        bank->y_mean[s] = 0;
+        bank->x_deviation_sum[s] = 0;
+        bank->xy_deviation_sum[s] = 0;
+    }
+    for(size_t slot=0;slot<bank->window;slot++){
+        double *x_slot = bank->x_history + slot*n, *y_slot = bank->y_history + slot*n;
+        for(size_t s=0;s<n;s++){
+            bank->x_mean[s] += x_slot[s];
+            bank->y_mean[s] += y_slot[s];
+        }
+    }
+    for(size_t s=0;s<n;s++){
+        bank->x_mean[s] /= bank->window;
+        bank->y_mean[s] /= bank->window;
+    }
+    for(size_t slot=0;slot<bank->window;slot++){
+        double *x_slot = bank->x_history + slot*n, *y_slot = bank->y_history + slot*n;
+        for(size_t s=0;s<n;s++){
+            double x_delta = x_slot[s] - bank->x_mean[s];
+            bank->x_deviation_sum[s] += x_delta*x_delta;
+            bank->xy_deviation_sum[s] += x_delta*(y_slot[s] - bank->y_mean[s]);
+        }
+    }
+}
+
+void linear_regression_bank_update(LinearRegressionBank *bank, double *x_data, double *y_data, size_t number_of_ticks){
+    size_t n = bank->number_of_series;
+    for(size_t t=0;t<number_of_ticks;t++){
+        double *x_tick = x_data + t*n, *y_tick = y_data + t*n;
+        if(bank->window == 0){
+            bank->weight = bank->decay*bank->weight + 1;
+            bank_add(bank, x_tick, y_tick, bank->decay, 1.0/bank->weight);
+        }
+        else if(bank->number_of_ticks < bank->window){
+            // Filling the window: plain additions, the ring fills from slot 0
+            bank->weight += 1;
+            bank_add(bank, x_tick, y_tick, 1.0, 1.0/bank->weight);
+            memcpy(bank->x_history + bank->number_of_ticks*n, x_tick, n*sizeof(double));
+            memcpy(bank->y_history + bank->number_of_ticks*n, y_tick, n*sizeof(double));
+        }
+        else{
+            double *x_old = bank->x_history + bank->history_head*n, *y_old = bank->y_history + bank->history_head*n;
+            bank_replace(bank, x_tick, y_tick, x_old, y_old, 1.0/bank->weight);
+            // The new tick takes the slot of the one that left
+            memcpy(x_old, x_tick, n*sizeof(double));
+            memcpy(y_old, y_tick, n*sizeof(double));
+            bank->history_head = (bank->history_head + 1) % bank->window;
+            if(bank->history_head == 0) bank_rebuild(bank);
+        }
+        bank->number_of_ticks++;
+    }
+}
+
+unsigned int linear_regression_bank_result(LinearRegressionBank *bank, size_t series, LinearRegressionResult *result_set){
+    if(series >= bank->number_of_series || bank->number_of_ticks < 2 || !(bank->x_deviation_sum[series] > 0)) return 2; // 2 is for arithmatic error
+    double slope = bank->xy_deviation_sum[series]/bank->x_deviation_sum[series];
+    result_set->slope = slope;
+    result_set->intercept = bank->y_mean[series] - slope*bank->x_mean[series];
+    return 0;
+}
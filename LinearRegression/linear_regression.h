@@ -23,6 +23,8 @@
 #ifndef LINEAR_REGRESSION_H
 #define LINEAR_REGRESSION_H
 
+#include <stddef.h>
+
 
 
 
@@ -33,6 +35,42 @@ double slope;
 double intercept;
 }LinearRegressionResult;
 
+/*
+ * Streaming state for simple linear regression. Instead of raw sums it keeps the running
+ * means and the centered sums of squares/products, which stay accurate even when the
+ * data is far away from the origin (raw sums of x^2 lose precision very quickly).
+ */
+typedef struct {
+unsigned long long number_of_data;
+double x_mean;
+double y_mean;
+double x_deviation_sum;   // sum of (x - mean(x))^2
+double xy_deviation_sum;  // sum of (x - mean(x)) * (y - mean(y))
+}LinearRegressionAccumulator;
+
+/*
+ * Online state of many simple linear regressions that receive one sample each per tick (e.g. one 
+ * series per sensor or instrument). It is stored as a struct of arrays: every quantity is one 
+ * contiguous array indexed by series, so a tick updates all series with SIMD instructions and 
+ * thousands of series stay in a few hundred KB. The model is either exponentially weighted 
+ * (`window` is 0) or an exact window of the last `window` ticks. The members are internal, use 
+ * the linear_regression_bank_* functions.
+ */
+typedef struct {
+size_t number_of_series;
+size_t window;                // ticks in the exact window, 0 for exponential decay
+double decay;                 // factor applied to the old weights every tick, 1 for a window
+double weight;                // total weight of the samples, equal for every series
+unsigned long long number_of_ticks;
+double *x_mean;               // per series
+double *y_mean;               // per series
+double *x_deviation_sum;      // per series, weighted sum of (x - mean(x))^2
+double *xy_deviation_sum;     // per series, weighted sum of (x - mean(x)) * (y - mean(y))
+double *x_history;            // window x number_of_series ring of the samples in the window, NULL for decay
+double *y_history;
+size_t history_head;          // ring slot of the oldest tick
+}LinearRegressionBank;
+
 
 /*
  * Function: linear_regression_train
@@ -155,5 +193,289 @@ double linear_regression_predict(LinearRegressionResult result_set, double x_new
  */
 
 
+/*
+ * Function: linear_regression_predict_batch
+ */
+
+void linear_regression_predict_batch(LinearRegressionResult *result_set, double *x_new, double *y_new, int number_of_data);
+/* ----------------------------
+ * This function predicts y for a whole array of x values in one call, using the same equation as 
+ * `linear_regression_predict`:
+ *    y_new[i] = m * x_new[i] + b
+ *
+ * Scoring point by point costs one function call (and one copy of the model) per value. This 
+ * function instead streams through the arrays with SIMD instructions. At runtime it checks the 
+ * CPU and uses the widest kernel available:
+ *    - AVX-512 (8 doubles per instruction)
+ *    - AVX2 (4 doubles per instruction)
+ *    - a plain scalar loop on any other CPU or compiler
+ * The SIMD kernels use fused multiply-add (m * x + b rounded once), so their results can differ 
+ * from `linear_regression_predict` in the last bit.
+ *
+ * Arguments:
+ *    - result_set: A pointer to a `LinearRegressionResult` structure containing the trained model.
+ *    - x_new: A pointer to an array of `number_of_data` x values.
+ *    - y_new: A pointer to an array of `number_of_data` doubles that receives the predictions. 
+ *      It may be the same array as `x_new` to predict in place.
+ *    - number_of_data: The number of values to predict.
+ *
+ * Returns:
+ *    - This function does not return a value. It fills `y_new`.
+ *
+ * Example:
+ *    LinearRegressionResult result_set = {2.5, 1.0};
+ *    double x_new[3] = {0.0, 1.0, 10.0}, y_new[3];
+ *    linear_regression_predict_batch(&result_set, x_new, y_new, 3); // y_new = {1.0, 3.5, 26.0}
+ */
+
+
+/*
+ * Function: linear_regression_accumulator_init
+ */
+
+void linear_regression_accumulator_init(LinearRegressionAccumulator *accumulator);
+/* ----------------------------
+ * This function resets a `LinearRegressionAccumulator` to the empty state (no data seen).
+ * It must be called before the first `linear_regression_accumulator_update` or 
+ * `linear_regression_accumulator_merge` on a freshly declared accumulator.
+ *
+ * Arguments:
+ *    - accumulator: A pointer to the `LinearRegressionAccumulator` to reset.
+ *
+ * Returns:
+ *    - This function does not return a value.
+ */
+
+
+/*
+ * Function: linear_regression_accumulator_update
+ */
+
+void linear_regression_accumulator_update(LinearRegressionAccumulator *accumulator, double *x_data, double *y_data, int number_of_data);
+/* ----------------------------
+ * This function absorbs one chunk of data points into the accumulator. It allows a model to be 
+ * trained on a stream of data in one pass with constant memory: only the current chunk has to 
+ * be in memory, the accumulator itself is a handful of doubles.
+ *
+ * The chunk is first summarised on its own (its means and centered sums), then combined with 
+ * the state of the accumulator using the pairwise update formula (Chan et al.):
+ *    n        = n_a + n_b
+ *    mean(x)  = mean_a(x) + (mean_b(x) - mean_a(x)) * n_b / n
+ *    Sxx      = Sxx_a + Sxx_b + (mean_b(x) - mean_a(x))^2 * n_a * n_b / n
+ *    Sxy      = Sxy_a + Sxy_b + (mean_b(x) - mean_a(x)) * (mean_b(y) - mean_a(y)) * n_a * n_b / n
+ * Where:
+ *    - Sxx is the sum of (x - mean(x))^2
+ *    - Sxy is the sum of (x - mean(x)) * (y - mean(y))
+ *
+ * Arguments:
+ *    - accumulator: A pointer to an initialised `LinearRegressionAccumulator`.
+ *    - x_data: A pointer to the x values of the chunk.
+ *    - y_data: A pointer to the y values of the chunk.
+ *    - number_of_data: The number of points in the chunk. Chunks of any size (including 0 or 1) 
+ *      are accepted.
+ *
+ * Returns:
+ *    - This function does not return a value. It updates the accumulator in place.
+ */
+
+
+/*
+ * Function: linear_regression_accumulator_merge
+ */
+
+void linear_regression_accumulator_merge(LinearRegressionAccumulator *destination, LinearRegressionAccumulator *source);
+/* ----------------------------
+ * This function combines two partial accumulators, e.g. ones built on different threads or hosts 
+ * over different parts of the data. After the call `destination` describes the union of both 
+ * data sets, exactly as if every chunk had been fed to a single accumulator. The same pairwise 
+ * update formula as `linear_regression_accumulator_update` is used.
+ *
+ * Arguments:
+ *    - destination: A pointer to the accumulator that receives the combined state.
+ *    - source: A pointer to the accumulator to merge in. It is not modified.
+ *
+ * Returns:
+ *    - This function does not return a value.
+ *
+ * Note:
+ *    - Floating point addition is not associative, so merging in a different order can change the 
+ *      last bits of the result. Merge in a fixed order if reproducible results are required.
+ */
+
+
+/*
+ * Function: linear_regression_accumulator_finalize
+ */
+
+unsigned int linear_regression_accumulator_finalize(LinearRegressionAccumulator *accumulator, LinearRegressionResult *result_set);
+/* ----------------------------
+ * This function computes the slope and intercept from the accumulated state:
+ *    - m (slope) = Sxy / Sxx
+ *    - b (intercept) = mean(y) - m * mean(x)
+ * The accumulator is left untouched, so more chunks may be added afterwards and the model 
+ * finalized again.
+ *
+ * Arguments:
+ *    - accumulator: A pointer to the accumulator holding the data summary.
+ *    - result_set: A pointer to a `LinearRegressionResult` structure which will be updated with the
+ *      calculated slope and intercept.
+ *
+ * Returns:
+ *    - `0` if the result was computed.
+ *    - `2` if an arithmetic error occurred (fewer than 2 points or all x values equal). In that
+ *      case `result_set` is not modified.
+ */
+
+/*
+ * Function: linear_regression_train_parallel
+ */
+
+unsigned int linear_regression_train_parallel(LinearRegressionResult *result_set, double *x_data, double *y_data, int number_of_data, unsigned int number_of_threads);
+/* ----------------------------
+ * This function trains the same model as `linear_regression_train`, but splits the data across 
+ * several worker threads (POSIX threads). It is meant for very large inputs where the single 
+ * pass over the data is the bottleneck.
+ *
+ * The data is cut into `number_of_threads` contiguous slices of (almost) equal size. Every worker 
+ * summarises its slice into its own `LinearRegressionAccumulator`, and once all workers are done 
+ * the partial accumulators are merged in slice order (0, 1, 2, ...). Because both the split and the 
+ * merge order only depend on `number_of_data` and `number_of_threads`, the result is bit-identical 
+ * between runs for a fixed thread count. Different thread counts may differ in the last bits.
+ *
+ * Arguments:
+ *    - result_set: A pointer to a `LinearRegressionResult` structure, which will be updated with the
+ *      calculated slope and intercept.
+ *    - x_data: A pointer to an array of doubles representing the independent variable (x).
+ *    - y_data: A pointer to an array of doubles representing the dependent variable (y).
+ *    - number_of_data: The number of data points in both x_data and y_data (should be at least 2).
+ *    - number_of_threads: The number of worker threads to use. 0 is treated as 1, and no more 
+ *      threads than data points are started.
+ *
+ * Returns:
+ *    - `0` if the training was successful.
+ *    - `1` if there was a system error (e.g., memory allocation or thread creation failure).
+ *    - `2` if an arithmetic error occurred (fewer than 2 points or all x values equal).
+ *
+ * Note:
+ *    - The calling program must be linked with `-pthread`.
+ *    - The calling thread processes the first slice itself, so `number_of_threads - 1` extra threads
+ *      are started. `number_of_threads` should usually be the number of available cores.
+ */
+
+
+/*
+ * Function: linear_regression_bank_alloc_decay
+ */
+
+LinearRegressionBank *linear_regression_bank_alloc_decay(size_t number_of_series, double half_life);
+/* ----------------------------
+ * This function creates a bank of `number_of_series` exponentially weighted regressions. Every 
+ * tick the weight of all previous samples is multiplied by 2^(-1/half_life), so a sample counts 
+ * half as much `half_life` ticks later and the model follows drifting data without ever keeping 
+ * old samples. A tick costs O(1) per series:
+ *    W        = decay * W + 1
+ *    mean(x) += (x - mean(x)) / W                      (the same for y)
+ *    Sxx      = decay * Sxx + (x - old mean(x)) * (x - new mean(x))
+ *    Sxy      = decay * Sxy + (x - old mean(x)) * (y - new mean(y))
+ * which is the weighted form of the centered sums of `LinearRegressionAccumulator`. W is shared 
+ * by all series, so 1/W is computed once per tick and the series need no division at all.
+ *
+ * Arguments:
+ *    - number_of_series: The number of independent regressions.
+ *    - half_life: The age in ticks at which a sample has half of its initial weight (> 0).
+ *
+ * Returns:
+ *    - A pointer to the bank, to be released with `linear_regression_bank_free`.
+ *    - `NULL` if an allocation failed, `number_of_series` is 0 or `half_life` is not positive.
+ */
+
+
+/*
+ * Function: linear_regression_bank_alloc_window
+ */
+
+LinearRegressionBank *linear_regression_bank_alloc_window(size_t number_of_series, size_t window);
+/* ----------------------------
+ * This function creates a bank of `number_of_series` regressions over exactly the last `window` 
+ * ticks, the same result as `linear_regression_train` on the last `window` points of each series 
+ * (up to rounding), for O(1) per series and tick instead of O(window). The bank keeps the 
+ * samples of the window in a ring (2 * window * number_of_series doubles). Once the window is 
+ * full, every tick replaces the oldest sample (o) by the new one (n) with the means kept fixed 
+ * in size W = window:
+ *    mean'(x) = mean(x) + (x_n - x_o) / W                (the same for y)
+ *    Sxx'     = Sxx + (x_n - mean(x))(x_n - mean'(x)) - (x_o - mean(x))(x_o - mean'(x))
+ *    Sxy'     = Sxy + (x_n - mean(x))(y_n - mean'(y)) - (x_o - mean(x))(y_o - mean'(y))
+ * All terms are centered, so removing samples does not suffer from the cancellation of raw sums. 
+ * The running means still collect rounding relative to the size of the data, which later 
+ * replacements multiply by x_n - x_o; so every `window` ticks (when the ring wraps) the sums are 
+ * recomputed from the ring in O(window) per series, still O(1) per tick on average.
+ *
+ * Arguments:
+ *    - number_of_series: The number of independent regressions.
+ *    - window: The number of ticks in the window (at least 2).
+ *
+ * Returns:
+ *    - A pointer to the bank, to be released with `linear_regression_bank_free`.
+ *    - `NULL` if an allocation failed, `number_of_series` is 0 or `window` is less than 2.
+ */
+
+
+/*
+ * Function: linear_regression_bank_free
+ */
+
+void linear_regression_bank_free(LinearRegressionBank *bank);
+/* ----------------------------
+ * This function frees a bank created by one of the linear_regression_bank_alloc_* functions. 
+ * Passing `NULL` does nothing.
+ */
+
+
+/*
+ * Function: linear_regression_bank_update
+ */
+
+void linear_regression_bank_update(LinearRegressionBank *bank, double *x_data, double *y_data, size_t number_of_ticks);
+/* ----------------------------
+ * This function feeds `number_of_ticks` ticks to the bank. A tick is one sample for every series, 
+ * so `x_data` and `y_data` hold `number_of_ticks` rows of `number_of_series` values each: 
+ * x_data[t * number_of_series + s] is the x of series s at tick t. Within a tick all series are 
+ * updated with the same instructions and no branches, 4 series at a time with AVX2 when the CPU 
+ * supports it (checked at runtime), which uses fused multiply-add and may differ from the plain 
+ * loop in the last bits.
+ *
+ * Arguments:
+ *    - bank: The bank.
+ *    - x_data: A pointer to number_of_ticks * number_of_series x values.
+ *    - y_data: A pointer to number_of_ticks * number_of_series y values.
+ *    - number_of_ticks: The number of ticks (rows) to feed, 1 for a live stream.
+ *
+ * Returns:
+ *    - This function does not return a value.
+ */
+
+
+/*
+ * Function: linear_regression_bank_result
+ */
+
+unsigned int linear_regression_bank_result(LinearRegressionBank *bank, size_t series, LinearRegressionResult *result_set);
+/* ----------------------------
+ * This function computes the current slope and intercept of one series in O(1):
+ *    - m (slope) = Sxy / Sxx
+ *    - b (intercept) = mean(y) - m * mean(x)
+ * It can be called after every tick; the bank is not modified.
+ *
+ * Arguments:
+ *    - bank: The bank.
+ *    - series: The index of the series (less than `number_of_series`).
+ *    - result_set: A pointer to a `LinearRegressionResult` structure which will be updated.
+ *
+ * Returns:
+ *    - `0` if the result was computed.
+ *    - `2` if an arithmetic error occurred (`series` out of range, fewer than 2 ticks seen or all x 
+ *      values in the model equal). In that case `result_set` is not modified.
+ */
+
 
 #endif // LINEAR_REGRESSION_H
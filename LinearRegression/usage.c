@@ -46,6 +46,20 @@ int main(){
     double predicted_y = linear_regression_predict(result,new_x);
     printf("\nPredicted y for x = %lf is y=%lf\n",new_x,predicted_y);
 
+    // Same data fed as a stream of 10 point chunks, merged from two partial accumulators
+    LinearRegressionAccumulator first_half, second_half;
+    linear_regression_accumulator_init(&first_half);
+    linear_regression_accumulator_init(&second_half);
+    for(int i=0;i<50;i+=10){
+        if(i<20)linear_regression_accumulator_update(&first_half,x_data+i,y_data+i,10);
+        else linear_regression_accumulator_update(&second_half,x_data+i,y_data+i,10);
+    }
+    linear_regression_accumulator_merge(&first_half,&second_half);
+
+    LinearRegressionResult streamed_result;
+    if(linear_regression_accumulator_finalize(&first_half,&streamed_result)==0){
+        printf("\nStreamed result:\nslope = %lf\nintercept = %lf\n",streamed_result.slope,streamed_result.intercept);
+    }
     
 
     return 0;
@@ -0,0 +1,150 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput of the logistic regression entry points on synthetic data.
+ * Usage: ./benchmark [-j] [-q] [-r repetitions]
+ *    -j  print the results as JSON, for tracking regressions between versions
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case, the median is reported (default 5)
+ * Labels come from a known weight vector through the sigmoid, at 10^3 to 10^6 rows and 8 or 64 
+ * features (sizes above 16M values are skipped). Exponentials are not counted as floating point 
+ * operations. See Benchmark/README.md for how the rates are defined.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "logistic_regression.h"
+#include "../Benchmark/benchmark_report.h"
+
+// Iterations per logistic_regression_train call
+#define BENCHMARK_ITERATIONS 10
+// Largest rows x features generated
+#define BENCHMARK_MAX_VALUES (1u<<24)
+
+typedef struct {
+gsl_matrix *x_data;
+gsl_vector *y_data;
+gsl_vector *prediction_set;
+gsl_vector *weight_set;
+LogisticWorkspace *workspace;
+}LogisticCase;
+
+static void run_train(void *context){
+    LogisticCase *c = context;
+    gsl_vector_set_zero(c->weight_set);
+    logistic_regression_train(c->y_data, c->x_data, c->weight_set, 0.5, BENCHMARK_ITERATIONS);
+}
+
+static void run_train_ws(void *context){
+    LogisticCase *c = context;
+    gsl_vector_set_zero(c->weight_set);
+    logistic_regression_train_ws(c->y_data, c->x_data, c->weight_set, 0.5, BENCHMARK_ITERATIONS, c->workspace);
+}
+
+static void run_train_scaled(void *context){
+    LogisticCase *c = context;
+    gsl_vector_set_zero(c->weight_set);
+    logistic_regression_train_scaled(c->y_data, c->x_data, c->weight_set, 0.5, BENCHMARK_ITERATIONS, NULL);
+}
+
+static void run_predict(void *context){
+    LogisticCase *c = context;
+    logistic_regression_predict(c->prediction_set, c->weight_set, c->x_data);
+}
+
+static void run_predict_ws(void *context){
+    LogisticCase *c = context;
+    logistic_regression_predict_ws(c->prediction_set, c->weight_set, c->x_data, c->workspace);
+}
+
+int main(int argc, char **argv){
+    BenchmarkReport report;
+    if(benchmark_parse_arguments(&report, "logistic_regression", argc, argv) != 0) return 1;
+    size_t row_sizes[] = {1000, 10000, 100000, 1000000};
+    size_t feature_sizes[] = {8, 64};
+    size_t number_of_row_sizes = report.quick ? 2 : 4;
+
+    benchmark_begin(&report);
+    for(size_t r=0;r<number_of_row_sizes;r++){
+        for(size_t f=0;f<2;f++){
+            size_t rows = row_sizes[r], features = feature_sizes[f];
+            if(rows*features > BENCHMARK_MAX_VALUES) continue;
+            LogisticCase c;
+            c.x_data = gsl_matrix_alloc(rows, features);
+            c.y_data = gsl_vector_alloc(rows);
+            c.prediction_set = gsl_vector_alloc(rows);
+            c.weight_set = gsl_vector_calloc(features);
+            c.workspace = logistic_workspace_alloc(rows, features);
+            if(!c.x_data||!c.y_data||!c.prediction_set||!c.weight_set||!c.workspace){
+                fprintf(stderr, "Could not allocate %zu x %zu data\n", rows, features);
+                return 1;
+            }
+            // Label 1 with probability sigmoid(1 + Σ (-1)^j x_j), bias in column 0
+            srand(42);
+            for(size_t i=0;i<rows;i++){
+                double z = 1.0;
+                gsl_matrix_set(c.x_data, i, 0, 1.0);
+                for(size_t j=1;j<features;j++){
+                    double value = 2.0*((double)rand()/RAND_MAX - 0.5);
+                    gsl_matrix_set(c.x_data, i, j, value);
+                    z += (j % 2) ? -value : value;
+                }
+                gsl_vector_set(c.y_data, i, ((double)rand()/RAND_MAX < sigmoid(z)) ? 1.0 : 0.0);
+            }
+            double m = rows, n = features;
+
+            // Every iteration: X*w and X^T*(p - y) (4mn), residual and update; X is read twice
+            BenchmarkResult result = {"logistic_regression_train", rows, features, BENCHMARK_ITERATIONS, 0, 
+                                      BENCHMARK_ITERATIONS*(4*m*n + m + 2*n), BENCHMARK_ITERATIONS*(16*m*n + 24*m)};
+            result.seconds = benchmark_time(run_train, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.function = "logistic_regression_train_ws";
+            result.seconds = benchmark_time(run_train_ws, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            // Plus one pass for the column statistics (3mn)
+            result.function = "logistic_regression_train_scaled";
+            result.flops += 3*m*n;
+            result.bytes += 8*m*n;
+            result.seconds = benchmark_time(run_train_scaled, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            // Prediction: X*w and the sigmoid, X read once and the probabilities written once
+            result.function = "logistic_regression_predict";
+            result.passes = 1;
+            result.flops = 2*m*n;
+            result.bytes = 8*m*n + 8*m;
+            result.seconds = benchmark_time(run_predict, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.function = "logistic_regression_predict_ws";
+            result.seconds = benchmark_time(run_predict_ws, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            gsl_matrix_free(c.x_data);
+            gsl_vector_free(c.y_data);
+            gsl_vector_free(c.prediction_set);
+            gsl_vector_free(c.weight_set);
+            logistic_workspace_free(c.workspace);
+        }
+    }
+    benchmark_end(&report);
+    return 0;
+}
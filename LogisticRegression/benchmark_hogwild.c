@@ -0,0 +1,130 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of logistic_regression_train_hogwild against the full batch logistic_regression_train.
+ * Usage: ./benchmark_hogwild [rows] [features] [epochs]
+ * Both get the same number of passes over the same synthetic data; Hogwild runs with 1, 8 and 32 
+ * threads. Prints the time, the passes per second and the mean loss and accuracy of the result.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <gsl/gsl_blas.h>
+#include "logistic_regression.h"
+
+static double seconds_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+// Mean log loss and accuracy of weight_set on the data
+static void evaluate(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, gsl_vector *z_data, double *loss, double *accuracy){
+    gsl_blas_dgemv(CblasNoTrans, 1.0, x_data, weight_set, 0.0, z_data);
+    double total = 0;
+    size_t correct = 0;
+    for(size_t i=0;i<x_data->size1;i++){
+        double z = gsl_vector_get(z_data, i), y = gsl_vector_get(y_data, i);
+        total += ((z > 0) ? z + log1p(exp(-z)) : log1p(exp(z))) - y*z;
+        if((z > 0) == (y > 0.5)) correct++;
+    }
+    *loss = total/x_data->size1;
+    *accuracy = (double)correct/x_data->size1;
+}
+
+int main(int argc, char **argv){
+    size_t rows = (argc > 1) ? strtoul(argv[1], NULL, 10) : 200000;
+    size_t features = (argc > 2) ? strtoul(argv[2], NULL, 10) : 32;
+    unsigned int epochs = (argc > 3) ? (unsigned int)atoi(argv[3]) : 10;
+    if(rows < 1 || features < 2 || epochs < 1){
+        printf("Usage: %s [rows >= 1] [features >= 2] [epochs >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    gsl_matrix *x_data = gsl_matrix_alloc(rows, features);
+    gsl_vector *y_data = gsl_vector_alloc(rows);
+    gsl_vector *true_weights = gsl_vector_alloc(features);
+    gsl_vector *weight_set = gsl_vector_alloc(features);
+    gsl_vector *z_data = gsl_vector_alloc(rows);
+    if(!x_data||!y_data||!true_weights||!weight_set||!z_data){
+        printf("Could not allocate %zu x %zu data\n", rows, features);
+        return 1;
+    }
+
+    // Labels drawn from a known logistic model, first column is the bias
+    srand(42);
+    for(size_t j=0;j<features;j++) gsl_vector_set(true_weights, j, 2.0*((double)rand()/RAND_MAX - 0.5));
+    for(size_t i=0;i<rows;i++){
+        gsl_matrix_set(x_data, i, 0, 1.0);
+        for(size_t j=1;j<features;j++) gsl_matrix_set(x_data, i, j, 2.0*((double)rand()/RAND_MAX - 0.5));
+    }
+    gsl_blas_dgemv(CblasNoTrans, 1.0, x_data, true_weights, 0.0, z_data);
+    for(size_t i=0;i<rows;i++){
+        gsl_vector_set(y_data, i, ((double)rand()/RAND_MAX < sigmoid(gsl_vector_get(z_data, i))) ? 1.0 : 0.0);
+    }
+
+    printf("rows: %zu, features: %zu, passes: %u\n", rows, features, epochs);
+    printf("%-18s %10s %12s %10s %10s\n", "method", "time (s)", "passes/s", "loss", "accuracy");
+
+    double loss, accuracy;
+    gsl_vector_set_zero(weight_set);
+    double start = seconds_now();
+    logistic_regression_train(y_data, x_data, weight_set, 0.5, epochs);
+    double seconds = seconds_now() - start;
+    evaluate(y_data, x_data, weight_set, z_data, &loss, &accuracy);
+    printf("%-18s %10.3f %12.2f %10.5f %10.4f\n", "full batch", seconds, epochs/seconds, loss, accuracy);
+
+    unsigned int thread_counts[3] = {1, 8, 32};
+    for(int k=0;k<3;k++){
+        LogisticHogwildOptions options;
+        logistic_hogwild_options_default(&options);
+        options.number_of_threads = thread_counts[k];
+        options.epochs = epochs;
+        options.learning_rate = 0.01;
+        options.seed = 42;
+        gsl_vector_set_zero(weight_set);
+        start = seconds_now();
+        unsigned int status = logistic_regression_train_hogwild(y_data, x_data, weight_set, &options, NULL, NULL);
+        seconds = seconds_now() - start;
+        if(status != 0){
+            printf("hogwild with %u threads failed with error code: %u\n", thread_counts[k], status);
+            continue;
+        }
+        evaluate(y_data, x_data, weight_set, z_data, &loss, &accuracy);
+        char name[32];
+        snprintf(name, sizeof(name), "hogwild %u thr", thread_counts[k]);
+        printf("%-18s %10.3f %12.2f %10.5f %10.4f\n", name, seconds, epochs/seconds, loss, accuracy);
+    }
+
+    // The loss of the weights that generated the labels is the best reachable on average
+    evaluate(y_data, x_data, true_weights, z_data, &loss, &accuracy);
+    printf("%-18s %10s %12s %10.5f %10.4f\n", "true weights", "-", "-", loss, accuracy);
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(true_weights);
+    gsl_vector_free(weight_set);
+    gsl_vector_free(z_data);
+    return 0;
+}
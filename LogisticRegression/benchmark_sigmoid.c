@@ -0,0 +1,120 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput benchmark for the sigmoid kernels.
+ * Usage: ./benchmark_sigmoid [n] [repetitions]
+ * Compares the element by element `sigmoid` loop the trainer used to run with sigmoid_vector and 
+ * log_sigmoid_vector in both accuracies, and reports the worst error of the fast kernels in ULP 
+ * against a long double reference.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "logistic_regression.h"
+
+static double seconds_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+// Distance between value and reference in units of the last place of the reference
+static double ulp_error(double value, long double reference){
+    double rounded = (double)reference;
+    double unit = nextafter(fabs(rounded), INFINITY) - fabs(rounded);
+    return (double)(fabsl((long double)value - reference)/unit);
+}
+
+static void report(const char *name, double seconds, size_t n, int repetitions, double baseline){
+    double per_element = seconds*1e9/((double)n*repetitions);
+    printf("%-26s %12.3f %12.3f %9.2fx\n", name, seconds, per_element, baseline/seconds);
+}
+
+int main(int argc, char **argv){
+    size_t n = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+    int repetitions = (argc > 2) ? atoi(argv[2]) : 100;
+    if(n < 1 || repetitions < 1){
+        printf("Usage: %s [n >= 1] [repetitions >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    gsl_vector *z = gsl_vector_alloc(n);
+    gsl_vector *output = gsl_vector_alloc(n);
+    if(!z||!output){
+        printf("Could not allocate %zu values\n", n);
+        if(z) gsl_vector_free(z);
+        if(output) gsl_vector_free(output);
+        return 1;
+    }
+
+    // Typical logits, with a few far into the tails
+    srand(42);
+    for(size_t i=0;i<n;i++){
+        double scale = (i % 64 == 0) ? 1400.0 : 40.0;
+        gsl_vector_set(z, i, ((double)rand()/RAND_MAX - 0.5)*scale);
+    }
+
+    printf("values: %zu, repetitions: %d\n", n, repetitions);
+    printf("%-26s %12s %12s %10s\n", "kernel", "time (s)", "ns/value", "speedup");
+
+    double start = seconds_now();
+    for(int r=0;r<repetitions;r++){
+        for(size_t i=0;i<n;i++) gsl_vector_set(output, i, sigmoid(gsl_vector_get(z, i)));
+    }
+    double baseline = seconds_now() - start;
+    report("sigmoid (scalar loop)", baseline, n, repetitions, baseline);
+
+    const char *names[4] = {"sigmoid_vector exact", "sigmoid_vector fast", "log_sigmoid_vector exact", "log_sigmoid_vector fast"};
+    for(int k=0;k<4;k++){
+        SigmoidAccuracy accuracy = (k % 2) ? SIGMOID_FAST : SIGMOID_EXACT;
+        start = seconds_now();
+        for(int r=0;r<repetitions;r++){
+            if(k < 2) sigmoid_vector(z->data, output->data, n, accuracy);
+            else log_sigmoid_vector(z->data, output->data, n, accuracy);
+        }
+        report(names[k], seconds_now() - start, n, repetitions, baseline);
+    }
+
+    // Worst error of the fast kernels over the range where they are accurate
+    double sigmoid_worst = 0, log_sigmoid_worst = 0;
+    sigmoid_vector(z->data, output->data, n, SIGMOID_FAST);
+    for(size_t i=0;i<n;i++){
+        long double value = z->data[i];
+        if(fabsl(value) > 708) continue;
+        double error = ulp_error(output->data[i], 1.0L/(1.0L + expl(-value)));
+        if(error > sigmoid_worst) sigmoid_worst = error;
+    }
+    log_sigmoid_vector(z->data, output->data, n, SIGMOID_FAST);
+    for(size_t i=0;i<n;i++){
+        long double value = z->data[i];
+        if(fabsl(value) > 708) continue;
+        double error = ulp_error(output->data[i], (value < 0 ? value : 0) - log1pl(expl(-fabsl(value))));
+        if(error > log_sigmoid_worst) log_sigmoid_worst = error;
+    }
+    printf("worst error of the fast kernels: sigmoid %.2f ULP, log_sigmoid %.2f ULP\n", sigmoid_worst, log_sigmoid_worst);
+
+    gsl_vector_free(z);
+    gsl_vector_free(output);
+    return 0;
+}
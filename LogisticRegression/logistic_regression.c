@@ -22,54 +22,280 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
 // math.h for exponential
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
 
 #include "logistic_regression.h"
 
+// SIMD kernels are only built for x86 with GCC/Clang, which can compile them per function and check the CPU at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LOGISTIC_X86_DISPATCH
+#endif
+
+double softplus(double z){
+    return (z > 0) ? z + log1p(exp(-z)) : log1p(exp(z));
+}
+
 double sigmoid(double x){
     return 1/(1+exp(-x));
 }
 
-unsigned int logistic_regression_train(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations) {
-    int m = y_data->size; // number of data points (rows)
-    int n = x_data->size2; // number of features (columns)
-    gsl_vector *z_data = gsl_vector_alloc(m);
-    gsl_vector *gradient = gsl_vector_alloc(n); 
-    gsl_vector *y_predicted = gsl_vector_alloc(m);
-    gsl_vector *error_set = gsl_vector_alloc(m);
-    if (!z_data || !gradient || !y_predicted||!error_set) {
-        if (z_data) gsl_vector_free(z_data);
-        if (gradient) gsl_vector_free(gradient);
-        if (y_predicted) gsl_vector_free(y_predicted);
-        if (error_set) gsl_vector_free(error_set);
-        return 1;
+/*
+Exact kernels on libm:
+  sigmoid(z) = 1/(1+exp(-z)), bit for bit the same as `sigmoid` (an overflowing exp gives 1/inf = 0, never NaN)
+  log(sigmoid(z)) = min(z,0) - log1p(exp(-|z|))
+ */
+static void sigmoid_vector_exact(const double *z, double *output, size_t n){
+    for(size_t i=0;i<n;i++){
+        output[i] = 1/(1+exp(-z[i]));
+    }
+}
+
+static void log_sigmoid_vector_exact(const double *z, double *output, size_t n){
+    for(size_t i=0;i<n;i++){
+        output[i] = fmin(z[i], 0.0) - log1p(exp(-fabs(z[i])));
     }
+}
+
+#ifdef LOGISTIC_X86_DISPATCH
+/*
+Fast kernels, all work from e = exp(t) with t = -|z| <= 0:
+  exp(t) = 2^k * exp(r),  k = round(t/ln2),  r = t - k*ln2 (ln2 split in two parts so k*ln2_hi is exact)
+  exp(r) is the degree 13 Taylor polynomial, |r| <= ln2/2 keeps the truncation below 1e-17.
+  log1p(e) = log(u) * e/(u-1) with u = 1+e (corrects the rounding of u), and
+  log(u) = j*ln2 + 2*atanh(s), s = (f-1)/(f+1), f = u/2^j in [0.70, 1.42], as an odd series in s up to s^21.
+For t < -708 exp(t) would leave the normal range, e is set to 0 there.
+ */
+#define FAST_EXP_MIN (-708.0)
+static const double exp_taylor[14] = {
+    1.0, 1.0, 1.0/2, 1.0/6, 1.0/24, 1.0/120, 1.0/720, 1.0/5040, 1.0/40320, 1.0/362880,
+    1.0/3628800, 1.0/39916800, 1.0/479001600, 1.0/6227020800.0
+};
+static const double atanh_series[11] = {
+    1.0, 1.0/3, 1.0/5, 1.0/7, 1.0/9, 1.0/11, 1.0/13, 1.0/15, 1.0/17, 1.0/19, 1.0/21
+};
+#define LOG2_E 1.44269504088896338700e+00
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+#define LN2 0.693147180559945309417
+#define SQRT2 1.41421356237309504880
+
+__attribute__((target("avx2,fma")))
+static inline __m256d exp_negative_avx2(__m256d t){
+    __m256d underflow = _mm256_cmp_pd(t, _mm256_set1_pd(FAST_EXP_MIN), _CMP_LT_OQ);
+    t = _mm256_max_pd(t, _mm256_set1_pd(FAST_EXP_MIN));
+    __m256d k = _mm256_round_pd(_mm256_mul_pd(t, _mm256_set1_pd(LOG2_E)), _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_HI), t);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_LO), r);
+    __m256d p = _mm256_set1_pd(exp_taylor[13]);
+    for(int j=12;j>=0;j--) p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(exp_taylor[j]));
+    // 2^k built in the exponent field: the low mantissa bits of (k + 1023 + 2^52) are k + 1023
+    __m256i biased = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(4503599627370496.0 + 1023.0)));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+    return _mm256_andnot_pd(underflow, _mm256_mul_pd(p, scale));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256d log1p_unit_avx2(__m256d e){
+    __m256d one = _mm256_set1_pd(1.0);
+    __m256d u = _mm256_add_pd(one, e);
+    __m256d upper = _mm256_cmp_pd(u, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+    __m256d f = _mm256_blendv_pd(u, _mm256_mul_pd(u, _mm256_set1_pd(0.5)), upper);
+    __m256d s = _mm256_div_pd(_mm256_sub_pd(f, one), _mm256_add_pd(f, one));
+    __m256d s2 = _mm256_mul_pd(s, s);
+    __m256d q = _mm256_set1_pd(atanh_series[10]);
+    for(int j=9;j>=0;j--) q = _mm256_fmadd_pd(q, s2, _mm256_set1_pd(atanh_series[j]));
+    __m256d log_u = _mm256_fmadd_pd(_mm256_add_pd(s, s), q, _mm256_and_pd(upper, _mm256_set1_pd(LN2)));
+    __m256d d = _mm256_sub_pd(u, one);
+    __m256d corrected = _mm256_mul_pd(log_u, _mm256_div_pd(e, _mm256_max_pd(d, _mm256_set1_pd(1e-300))));
+    return _mm256_blendv_pd(corrected, e, _mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256d sigmoid_avx2(__m256d z){
+    __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d e = exp_negative_avx2(_mm256_or_pd(z, sign_mask)); // exp(-|z|)
+    __m256d positive = _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_add_pd(_mm256_set1_pd(1.0), e));
+    return _mm256_blendv_pd(positive, _mm256_mul_pd(e, positive), z); // blend on the sign bit of z
+}
+
+__attribute__((target("avx2,fma")))
+static inline __m256d log_sigmoid_avx2(__m256d z){
+    __m256d e = exp_negative_avx2(_mm256_or_pd(z, _mm256_set1_pd(-0.0)));
+    return _mm256_sub_pd(_mm256_min_pd(z, _mm256_setzero_pd()), log1p_unit_avx2(e));
+}
+
+__attribute__((target("avx2,fma")))
+static void sigmoid_vector_avx2(const double *z, double *output, size_t n, int logarithm){
+    size_t i = 0;
+    for(;i+4<=n;i+=4){
+        __m256d value = _mm256_loadu_pd(z+i);
+        _mm256_storeu_pd(output+i, logarithm ? log_sigmoid_avx2(value) : sigmoid_avx2(value));
+    }
+    if(i < n){
+        // Pad the last 1-3 values so they take the same path as the rest
+        double buffer[4] = {0, 0, 0, 0};
+        for(size_t j=0;j<n-i;j++) buffer[j] = z[i+j];
+        __m256d value = _mm256_loadu_pd(buffer);
+        _mm256_storeu_pd(buffer, logarithm ? log_sigmoid_avx2(value) : sigmoid_avx2(value));
+        for(size_t j=0;j<n-i;j++) output[i+j] = buffer[j];
+    }
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d exp_negative_avx512(__m512d t){
+    __mmask8 underflow = _mm512_cmp_pd_mask(t, _mm512_set1_pd(FAST_EXP_MIN), _CMP_LT_OQ);
+    t = _mm512_max_pd(t, _mm512_set1_pd(FAST_EXP_MIN));
+    __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(t, _mm512_set1_pd(LOG2_E)), _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_HI), t);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_LO), r);
+    __m512d p = _mm512_set1_pd(exp_taylor[13]);
+    for(int j=12;j>=0;j--) p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(exp_taylor[j]));
+    return _mm512_maskz_scalef_pd((__mmask8)~underflow, p, k); // p * 2^k
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d log1p_unit_avx512(__m512d e){
+    __m512d one = _mm512_set1_pd(1.0);
+    __m512d u = _mm512_add_pd(one, e);
+    __mmask8 upper = _mm512_cmp_pd_mask(u, _mm512_set1_pd(SQRT2), _CMP_GT_OQ);
+    __m512d f = _mm512_mask_mul_pd(u, upper, u, _mm512_set1_pd(0.5));
+    __m512d s = _mm512_div_pd(_mm512_sub_pd(f, one), _mm512_add_pd(f, one));
+    __m512d s2 = _mm512_mul_pd(s, s);
+    __m512d q = _mm512_set1_pd(atanh_series[10]);
+    for(int j=9;j>=0;j--) q = _mm512_fmadd_pd(q, s2, _mm512_set1_pd(atanh_series[j]));
+    __m512d log_u = _mm512_fmadd_pd(_mm512_add_pd(s, s), q, _mm512_maskz_mov_pd(upper, _mm512_set1_pd(LN2)));
+    __m512d d = _mm512_sub_pd(u, one);
+    __mmask8 exact = _mm512_cmp_pd_mask(d, _mm512_setzero_pd(), _CMP_EQ_OQ);
+    __m512d corrected = _mm512_mul_pd(log_u, _mm512_div_pd(e, _mm512_max_pd(d, _mm512_set1_pd(1e-300))));
+    return _mm512_mask_mov_pd(corrected, exact, e);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d sigmoid_avx512(__m512d z){
+    __mmask8 negative = _mm512_cmp_pd_mask(z, _mm512_setzero_pd(), _CMP_LT_OQ);
+    __m512d e = exp_negative_avx512(_mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(z), _mm512_set1_epi64((long long)0x8000000000000000ULL))));
+    __m512d positive = _mm512_div_pd(_mm512_set1_pd(1.0), _mm512_add_pd(_mm512_set1_pd(1.0), e));
+    return _mm512_mask_mul_pd(positive, negative, e, positive);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d log_sigmoid_avx512(__m512d z){
+    __m512d e = exp_negative_avx512(_mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(z), _mm512_set1_epi64((long long)0x8000000000000000ULL))));
+    return _mm512_sub_pd(_mm512_min_pd(z, _mm512_setzero_pd()), log1p_unit_avx512(e));
+}
+
+__attribute__((target("avx512f")))
+static void sigmoid_vector_avx512(const double *z, double *output, size_t n, int logarithm){
+    for(size_t i=0;i<n;i+=8){
+        // Masked load/store covers the last 1-7 values
+        __mmask8 mask = (n-i >= 8) ? (__mmask8)0xFF : (__mmask8)((1u << (n-i)) - 1);
+        __m512d value = _mm512_maskz_loadu_pd(mask, z+i);
+        _mm512_mask_storeu_pd(output+i, mask, logarithm ? log_sigmoid_avx512(value) : sigmoid_avx512(value));
+    }
+}
+#endif
+
+static void sigmoid_dispatch(const double *z, double *output, size_t n, SigmoidAccuracy accuracy, int logarithm){
+#ifdef LOGISTIC_X86_DISPATCH
+    if(accuracy == SIGMOID_FAST){
+        if(__builtin_cpu_supports("avx512f")){
+            sigmoid_vector_avx512(z, output, n, logarithm);
+            return;
+        }
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+            sigmoid_vector_avx2(z, output, n, logarithm);
+            return;
+        }
+    }
+#else
+    (void)accuracy;
+#endif
+    if(logarithm) log_sigmoid_vector_exact(z, output, n);
+    else sigmoid_vector_exact(z, output, n);
+}
+
+void sigmoid_vector(const double *z, double *output, size_t n, SigmoidAccuracy accuracy){
+    sigmoid_dispatch(z, output, n, accuracy, 0);
+}
+
+void log_sigmoid_vector(const double *z, double *output, size_t n, SigmoidAccuracy accuracy){
+    sigmoid_dispatch(z, output, n, accuracy, 1);
+}
+
+/*
+z_data, y_predicted and error_set (m each) and gradient (n) are contiguous scratch space, overwritten
+telemetry may be NULL; returns 3 if its callback stops training
+With telemetry the two products go to TELEMETRY_PRODUCTS and the activation, error and update to TELEMETRY_UPDATE, sampling is in neither
+ */
+static unsigned int logistic_regression_train_into(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, gsl_vector *z_data, gsl_vector *y_predicted, gsl_vector *error_set, gsl_vector *gradient, SigmoidAccuracy accuracy, TrainingTelemetry *telemetry){
+    int m = y_data->size; // number of data points (rows)
 
     for (unsigned int i = 0; i < iterations; i++) {
+        double lap = telemetry ? telemetry_now() : 0;
         // z_data = x_data * weight_set
         gsl_blas_dgemv(CblasNoTrans, 1, x_data, weight_set, 0, z_data);
+        if(telemetry) lap = telemetry_lap(telemetry, TELEMETRY_PRODUCTS, lap);
 
         // Predict values with current weights
-        for (unsigned int j = 0; j < m; j++) {
-            double sig = sigmoid(gsl_vector_get(z_data, j));
-            gsl_vector_set(y_predicted, j, sig);
-        }
+        sigmoid_vector(z_data->data, y_predicted->data, m, accuracy);
         // Compute gradient = x_data_transpose * (y_predicted - y_data)
         // Create a vector that holds the error_set (y_predicted - y_data)
         
         gsl_vector_memcpy(error_set, y_predicted);
         gsl_vector_sub(error_set, y_data);
+        if(telemetry) lap = telemetry_lap(telemetry, TELEMETRY_UPDATE, lap);
 
         // Compute gradient = x_data_transpose * error_set
         gsl_blas_dgemv(CblasTrans, 1, x_data, error_set, 0, gradient); // gradient = X^T * (y_pred - y)
+        if(telemetry) telemetry_lap(telemetry, TELEMETRY_PRODUCTS, lap);
+
+        if(telemetry && telemetry->sample_stride && i % telemetry->sample_stride == 0){
+            double loss = 0;
+            for(int j=0;j<m;j++){
+                double z = gsl_vector_get(z_data, j);
+                loss += softplus(z) - gsl_vector_get(y_data, j)*z;
+            }
+            if(telemetry_record(telemetry, i, loss/m, gsl_blas_dnrm2(gradient)/m)) return 3;
+        }
 
+        lap = telemetry ? telemetry_now() : 0;
         // Update weight_set = weight_set - (learning_rate / m) * gradient
         gsl_vector_scale(gradient, learning_rate / m);
         gsl_vector_sub(weight_set, gradient);
+        if(telemetry) telemetry_lap(telemetry, TELEMETRY_UPDATE, lap);
+        if(telemetry) telemetry->iterations = i + 1;
 
         
     }
+    return 0;
+}
+
+unsigned int logistic_regression_train(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations) {
+    int m = y_data->size; // number of data points (rows)
+    int n = x_data->size2; // number of features (columns)
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *gradient = gsl_vector_alloc(n); 
+    gsl_vector *y_predicted = gsl_vector_alloc(m);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    if (!z_data || !gradient || !y_predicted||!error_set) {
+        if (z_data) gsl_vector_free(z_data);
+        if (gradient) gsl_vector_free(gradient);
+        if (y_predicted) gsl_vector_free(y_predicted);
+        if (error_set) gsl_vector_free(error_set);
+        return 1;
+    }
+
+    logistic_regression_train_into(y_data, x_data, weight_set, learning_rate, iterations, z_data, y_predicted, error_set, gradient, SIGMOID_EXACT, NULL);
+
     gsl_vector_free(error_set);
     gsl_vector_free(z_data);
     gsl_vector_free(gradient);
@@ -77,20 +303,658 @@ unsigned int logistic_regression_train(gsl_vector *y_data, gsl_matrix *x_data, g
     return 0;
 }
 
+unsigned int logistic_regression_train_instrumented(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, TrainingTelemetry *telemetry){
+    telemetry_reset(telemetry);
+    size_t m = y_data->size, n = x_data->size2;
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *y_predicted = gsl_vector_alloc(m);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    telemetry->allocations = 4;
+    if (!z_data || !gradient || !y_predicted||!error_set) {
+        if (z_data) gsl_vector_free(z_data);
+        if (gradient) gsl_vector_free(gradient);
+        if (y_predicted) gsl_vector_free(y_predicted);
+        if (error_set) gsl_vector_free(error_set);
+        return 1;
+    }
+
+    double start = telemetry_now();
+    unsigned int status = logistic_regression_train_into(y_data, x_data, weight_set, learning_rate, iterations, z_data, y_predicted, error_set, gradient, SIGMOID_EXACT, telemetry);
+    telemetry_lap(telemetry, TELEMETRY_ITERATIONS, start);
+    // Every iteration reads X twice and streams the m-vectors z, predictions, y and error; a sample reads z and y again
+    unsigned long long passes = telemetry->iterations + (status == 3);
+    telemetry->bytes_touched = passes*(16ull*m*n + 40ull*m) + telemetry->samples*16ull*m;
+
+    gsl_vector_free(error_set);
+    gsl_vector_free(z_data);
+    gsl_vector_free(gradient);
+    gsl_vector_free(y_predicted);
+    return status;
+}
+
 int probability(double x){
     return (x>0.5)?1:0;
 }
-unsigned int logistic_regression_predict(gsl_vector *prediction_set,gsl_vector *weight_set, gsl_matrix *x_data){
+
+// z_data (n, contiguous) is scratch space, overwritten
+static void logistic_regression_predict_into(gsl_vector *prediction_set,gsl_vector *weight_set, gsl_matrix *x_data, gsl_vector *z_data, SigmoidAccuracy accuracy){
     int n = x_data->size1;
-    gsl_vector *z_data = gsl_vector_alloc(n);
-    if(!z_data)return 1;
     // z_data = x_data * weight_set
     gsl_blas_dgemv(CblasNoTrans, 1, x_data, weight_set, 0, z_data);
 
+    sigmoid_vector(z_data->data, z_data->data, n, accuracy);
     for(int i=0;i<n;i++){
-        double sig = sigmoid(gsl_vector_get(z_data,i));
-        gsl_vector_set(prediction_set,i,probability(sig));
+        gsl_vector_set(prediction_set,i,probability(gsl_vector_get(z_data,i)));
     }
+}
+
+unsigned int logistic_regression_predict(gsl_vector *prediction_set,gsl_vector *weight_set, gsl_matrix *x_data){
+    int n = x_data->size1;
+    gsl_vector *z_data = gsl_vector_alloc(n);
+    if(!z_data)return 1;
+    logistic_regression_predict_into(prediction_set, weight_set, x_data, z_data, SIGMOID_EXACT);
+    gsl_vector_free(z_data);
     return 0;
     
 }
+
+unsigned int logistic_regression_train_csr(gsl_vector *y_data, CSRMatrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations){
+    size_t m = x_data->rows; // number of data points (rows)
+    size_t n = x_data->columns; // number of features (columns)
+    if(m == 0 || y_data->size != m || weight_set->size != n) return 2;
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    if(!z_data||!gradient){
+        if(z_data) gsl_vector_free(z_data);
+        if(gradient) gsl_vector_free(gradient);
+        return 1;
+    }
+
+    for(unsigned int i=0;i<iterations;i++){
+        // z_data = x_data * weight_set, then sigmoid(z) - y in place
+        csr_dgemv(CblasNoTrans, 1.0, x_data, weight_set, 0.0, z_data);
+        sigmoid_vector(z_data->data, z_data->data, m, SIGMOID_EXACT);
+        gsl_vector_sub(z_data, y_data);
+
+        // weight_set = weight_set - (learning_rate / m) * X^T * (y_pred - y)
+        csr_dgemv(CblasTrans, learning_rate/m, x_data, z_data, 0.0, gradient);
+        gsl_vector_sub(weight_set, gradient);
+    }
+
+    gsl_vector_free(z_data);
+    gsl_vector_free(gradient);
+    return 0;
+}
+
+unsigned int logistic_regression_predict_csr(gsl_vector *prediction_set, gsl_vector *weight_set, CSRMatrix *x_data){
+    size_t n = x_data->rows;
+    if(prediction_set->size != n || weight_set->size != x_data->columns) return 2;
+    if(n == 0) return 0;
+    gsl_vector *z_data = gsl_vector_alloc(n);
+    if(!z_data)return 1;
+    csr_dgemv(CblasNoTrans, 1.0, x_data, weight_set, 0.0, z_data);
+    sigmoid_vector(z_data->data, z_data->data, n, SIGMOID_EXACT);
+    for(size_t i=0;i<n;i++){
+        gsl_vector_set(prediction_set,i,probability(gsl_vector_get(z_data,i)));
+    }
+    gsl_vector_free(z_data);
+    return 0;
+}
+
+// Rows per tile of logistic_regression_train_float: the tile is read again right after scoring it, from cache
+#define FLOAT_TILE_ROWS 256
+
+unsigned int logistic_regression_train_float(gsl_vector_float *y_data, gsl_matrix_float *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations){
+    size_t m = x_data->size1; // number of data points (rows)
+    size_t n = x_data->size2; // number of features (columns)
+    if(m == 0 || y_data->size != m || weight_set->size != n) return 2;
+
+    double *weights = malloc(n*sizeof(double));
+    double *gradient = malloc(n*sizeof(double));
+    double *z_tile = malloc(FLOAT_TILE_ROWS*sizeof(double));
+    if(!weights||!gradient||!z_tile){
+        free(weights);
+        free(gradient);
+        free(z_tile);
+        return 1;
+    }
+    for(size_t j=0;j<n;j++) weights[j] = gsl_vector_get(weight_set, j);
+
+    for(unsigned int it=0;it<iterations;it++){
+        memset(gradient, 0, n*sizeof(double));
+        for(size_t start=0;start<m;start+=FLOAT_TILE_ROWS){
+            size_t rows = (m - start < FLOAT_TILE_ROWS) ? m - start : FLOAT_TILE_ROWS;
+            // z = X_tile * w in double, then the sigmoid kernel on the whole tile
+            for(size_t r=0;r<rows;r++){
+                const float *row = x_data->data + (start + r)*x_data->tda;
+                double z = 0;
+                for(size_t j=0;j<n;j++) z += (double)row[j]*weights[j];
+                z_tile[r] = z;
+            }
+            sigmoid_vector(z_tile, z_tile, rows, SIGMOID_EXACT);
+            // gradient += X_tile^T * (sigmoid(z) - y)
+            for(size_t r=0;r<rows;r++){
+                const float *row = x_data->data + (start + r)*x_data->tda;
+                double error = z_tile[r] - (double)y_data->data[(start + r)*y_data->stride];
+                for(size_t j=0;j<n;j++) gradient[j] += error*(double)row[j];
+            }
+        }
+        // Update weight_set = weight_set - (learning_rate / m) * gradient
+        double step = learning_rate/m;
+        for(size_t j=0;j<n;j++) weights[j] -= step*gradient[j];
+    }
+
+    for(size_t j=0;j<n;j++) gsl_vector_set(weight_set, j, weights[j]);
+    free(weights);
+    free(gradient);
+    free(z_tile);
+    return 0;
+}
+
+unsigned int logistic_regression_predict_float(gsl_vector_float *prediction_set, gsl_vector *weight_set, gsl_matrix_float *x_data){
+    size_t n = x_data->size2;
+    if(prediction_set->size != x_data->size1 || weight_set->size != n) return 2;
+    // The weights are read in place, without a bounds checked call per element in the inner loop
+    const double *weights = weight_set->data;
+    size_t weight_stride = weight_set->stride;
+    for(size_t i=0;i<x_data->size1;i++){
+        const float *row = x_data->data + i*x_data->tda;
+        double z = 0;
+        for(size_t j=0;j<n;j++) z += (double)row[j]*weights[j*weight_stride];
+        // sigmoid(z) > 0.5 exactly when z > 0
+        prediction_set->data[i*prediction_set->stride] = (float)probability(sigmoid(z));
+    }
+    return 0;
+}
+
+unsigned int logistic_regression_train_scaled(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, FeatureScaling *scaling){
+    size_t m = y_data->size, n = x_data->size2;
+    if (m == 0 || x_data->size1 != m || weight_set->size != n) return 2;
+
+    FeatureScaling local = {0}, *statistics = NULL;
+    double constant_value = 1;
+    gsl_vector *scaled_set = gsl_vector_alloc(n);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    unsigned int status = 1; // 1 is for system error
+    if (!scaled_set || !gradient || !z_data || !error_set) goto cleanup;
+    status = feature_scaling_prepare(x_data, scaling, &local, &statistics, &constant_value);
+    if (status != 0) goto cleanup;
+
+    // The steps are taken on the standardised weights; weight_set always holds the same model for 
+    // the original columns, so the products use x_data as it is
+    feature_scaling_to_scaled(statistics, constant_value, weight_set, scaled_set);
+    for (unsigned int i = 0; i < iterations; i++) {
+        // error_set = sigmoid(x_data * weight_set) - y_data
+        gsl_blas_dgemv(CblasNoTrans, 1, x_data, weight_set, 0, z_data);
+        sigmoid_vector(z_data->data, error_set->data, m, SIGMOID_EXACT);
+        gsl_vector_sub(error_set, y_data);
+
+        // gradient = x_data_transpose * error_set, then for the standardised columns
+        gsl_blas_dgemv(CblasTrans, 1, x_data, error_set, 0, gradient);
+        feature_scaling_gradient(statistics, constant_value, gradient);
+
+        gsl_blas_daxpy(-learning_rate / m, gradient, scaled_set);
+        feature_scaling_from_scaled(statistics, constant_value, scaled_set, weight_set);
+    }
+
+cleanup:
+    if (local.mean) gsl_vector_free(local.mean);
+    if (local.deviation) gsl_vector_free(local.deviation);
+    if (scaled_set) gsl_vector_free(scaled_set);
+    if (gradient) gsl_vector_free(gradient);
+    if (z_data) gsl_vector_free(z_data);
+    if (error_set) gsl_vector_free(error_set);
+    return status;
+}
+
+LogisticWorkspace *logistic_workspace_alloc(size_t number_of_data, size_t number_of_features){
+    if(number_of_data==0||number_of_features==0)return NULL;
+    LogisticWorkspace *workspace = calloc(1, sizeof(LogisticWorkspace));
+    if(!workspace)return NULL;
+    workspace->number_of_data = number_of_data;
+    workspace->number_of_features = number_of_features;
+    workspace->accuracy = SIGMOID_EXACT;
+    workspace->z_data = gsl_vector_alloc(number_of_data);
+    workspace->y_predicted = gsl_vector_alloc(number_of_data);
+    workspace->error_set = gsl_vector_alloc(number_of_data);
+    workspace->gradient = gsl_vector_alloc(number_of_features);
+    if(!workspace->z_data||!workspace->y_predicted||!workspace->error_set||!workspace->gradient){
+        logistic_workspace_free(workspace);
+        return NULL;
+    }
+    return workspace;
+}
+
+void logistic_workspace_free(LogisticWorkspace *workspace){
+    if(!workspace)return;
+    if(workspace->z_data)gsl_vector_free(workspace->z_data);
+    if(workspace->y_predicted)gsl_vector_free(workspace->y_predicted);
+    if(workspace->error_set)gsl_vector_free(workspace->error_set);
+    if(workspace->gradient)gsl_vector_free(workspace->gradient);
+    free(workspace);
+}
+
+// The data must have exactly the workspace's features and at most its rows
+static int logistic_workspace_fits(LogisticWorkspace *workspace, gsl_matrix *x_data){
+    return workspace && x_data->size2 == workspace->number_of_features && x_data->size1 <= workspace->number_of_data;
+}
+
+unsigned int logistic_regression_train_ws(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, LogisticWorkspace *workspace){
+    if(!logistic_workspace_fits(workspace, x_data))return 2;
+    // Views over the first m entries, so fewer rows than the workspace was sized for still allocate nothing
+    size_t m = x_data->size1;
+    gsl_vector_view z_data = gsl_vector_subvector(workspace->z_data, 0, m);
+    gsl_vector_view y_predicted = gsl_vector_subvector(workspace->y_predicted, 0, m);
+    gsl_vector_view error_set = gsl_vector_subvector(workspace->error_set, 0, m);
+    logistic_regression_train_into(y_data, x_data, weight_set, learning_rate, iterations, &z_data.vector, &y_predicted.vector, &error_set.vector, workspace->gradient, workspace->accuracy, NULL);
+    return 0;
+}
+
+unsigned int logistic_regression_predict_ws(gsl_vector *prediction_set, gsl_vector *weight_set, gsl_matrix *x_data, LogisticWorkspace *workspace){
+    if(!logistic_workspace_fits(workspace, x_data))return 2;
+    gsl_vector_view z_data = gsl_vector_subvector(workspace->z_data, 0, x_data->size1);
+    logistic_regression_predict_into(prediction_set, weight_set, x_data, &z_data.vector, workspace->accuracy);
+    return 0;
+}
+
+void logistic_solver_options_default(LogisticSolverOptions *options){
+    options->max_iterations = 100;
+    options->tolerance = 1e-8;
+    options->l2_regularisation = 0.0;
+    options->history_size = 10;
+}
+
+/*
+Regularised mean negative log likelihood at weight_set:
+  f(w) = (1/m) * Σ [log(1+exp(z_i)) - y_i*z_i] + (λ/2)*||w||^2   with z = X*w
+Leaves z in z_data and sigmoid(z) - y in error_set. When gradient is not NULL it also gets
+  gradient = (1/m) * X^T * (sigmoid(z) - y) + λ*w
+ */
+static double logistic_objective(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double l2_regularisation, gsl_vector *z_data, gsl_vector *error_set, gsl_vector *gradient){
+    size_t m = x_data->size1;
+    gsl_blas_dgemv(CblasNoTrans, 1.0, x_data, weight_set, 0.0, z_data);
+
+    double loss = 0;
+    for(size_t i=0;i<m;i++){
+        double z = gsl_vector_get(z_data, i),
+               y = gsl_vector_get(y_data, i);
+        loss += softplus(z) - y*z;
+        gsl_vector_set(error_set, i, sigmoid(z) - y);
+    }
+    double weight_norm = gsl_blas_dnrm2(weight_set);
+    loss = loss/m + 0.5*l2_regularisation*weight_norm*weight_norm;
+
+    if(gradient){
+        gsl_vector_memcpy(gradient, weight_set);
+        gsl_blas_dgemv(CblasTrans, 1.0/m, x_data, error_set, l2_regularisation, gradient);
+    }
+    return loss;
+}
+
+// Rows per tile when forming X^T * S * X in logistic_regression_train_irls
+#define IRLS_TILE_ROWS 256
+
+unsigned int logistic_regression_train_irls(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticSolverOptions *options, unsigned int *iterations_run){
+    size_t m = x_data->size1; // number of data points (rows)
+    size_t n = x_data->size2; // number of features (columns)
+    size_t tile_rows = (m < IRLS_TILE_ROWS) ? m : IRLS_TILE_ROWS;
+    if(iterations_run) *iterations_run = 0;
+    if(m == 0) return 0;
+
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *step = gsl_vector_alloc(n);
+    gsl_vector *previous_weights = gsl_vector_alloc(n);
+    gsl_matrix *hessian = gsl_matrix_alloc(n, n);
+    gsl_matrix *tile = gsl_matrix_alloc(tile_rows, n);
+    unsigned int status = 0;
+    if(!z_data||!error_set||!gradient||!step||!previous_weights||!hessian||!tile){
+        status = 1;
+        goto cleanup;
+    }
+
+    double loss = logistic_objective(y_data, x_data, weight_set, options->l2_regularisation, z_data, error_set, gradient);
+    for(unsigned int iteration=0;iteration<options->max_iterations;iteration++){
+        if(gsl_blas_dnrm2(gradient) < options->tolerance) break;
+
+        // hessian = (1/m) * X^T * S * X + λ*I with S = diag(p_i*(1-p_i)), built from tiles of rows scaled by sqrt(s_i/m)
+        gsl_matrix_set_zero(hessian);
+        for(size_t start=0;start<m;start+=tile_rows){
+            size_t rows = (m-start < tile_rows) ? m-start : tile_rows;
+            for(size_t r=0;r<rows;r++){
+                double p = sigmoid(gsl_vector_get(z_data, start+r)),
+                       scale = sqrt(p*(1-p)/m);
+                for(size_t j=0;j<n;j++) gsl_matrix_set(tile, r, j, scale*gsl_matrix_get(x_data, start+r, j));
+            }
+            gsl_matrix_view tile_rows_view = gsl_matrix_submatrix(tile, 0, 0, rows, n);
+            gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &tile_rows_view.matrix, 1.0, hessian);
+        }
+        for(size_t i=0;i<n;i++){
+            for(size_t j=0;j<i;j++) gsl_matrix_set(hessian, j, i, gsl_matrix_get(hessian, i, j));
+            gsl_matrix_set(hessian, i, i, gsl_matrix_get(hessian, i, i) + options->l2_regularisation);
+        }
+
+        // Newton step: solve hessian * step = gradient with the Cholesky factors, as in mlr_train
+        if(gsl_linalg_cholesky_decomp(hessian)!=GSL_SUCCESS || gsl_linalg_cholesky_solve(hessian, gradient, step)!=GSL_SUCCESS){
+            status = 2; // 2 is for arithmatic error
+            break;
+        }
+
+        // Backtracking: halve the step until the loss decreases enough (Armijo condition)
+        double slope, step_length = 1.0, new_loss = loss;
+        gsl_blas_ddot(gradient, step, &slope);
+        gsl_vector_memcpy(previous_weights, weight_set);
+        int accepted = 0;
+        for(int halving=0;halving<30;halving++){
+            gsl_vector_memcpy(weight_set, previous_weights);
+            gsl_blas_daxpy(-step_length, step, weight_set);
+            new_loss = logistic_objective(y_data, x_data, weight_set, options->l2_regularisation, z_data, error_set, NULL);
+            if(new_loss <= loss - 1e-4*step_length*slope){
+                accepted = 1;
+                break;
+            }
+            step_length *= 0.5;
+        }
+        if(iterations_run) *iterations_run = iteration+1;
+        if(!accepted){
+            // No decrease possible along the Newton direction, we are at the minimum to machine precision
+            gsl_vector_memcpy(weight_set, previous_weights);
+            break;
+        }
+
+        // z_data and error_set already belong to the new weights, only the gradient product is left
+        loss = new_loss;
+        gsl_vector_memcpy(gradient, weight_set);
+        gsl_blas_dgemv(CblasTrans, 1.0/m, x_data, error_set, options->l2_regularisation, gradient);
+    }
+
+cleanup:
+    if(z_data)gsl_vector_free(z_data);
+    if(error_set)gsl_vector_free(error_set);
+    if(gradient)gsl_vector_free(gradient);
+    if(step)gsl_vector_free(step);
+    if(previous_weights)gsl_vector_free(previous_weights);
+    if(hessian)gsl_matrix_free(hessian);
+    if(tile)gsl_matrix_free(tile);
+    return status;
+}
+
+unsigned int logistic_regression_train_lbfgs(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticSolverOptions *options, unsigned int *iterations_run){
+    size_t m = x_data->size1; // number of data points (rows)
+    size_t n = x_data->size2; // number of features (columns)
+    size_t history_size = (options->history_size > 0) ? options->history_size : 1;
+    if(iterations_run) *iterations_run = 0;
+    if(m == 0) return 0;
+
+    gsl_vector *z_data = gsl_vector_alloc(m);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *new_gradient = gsl_vector_alloc(n);
+    gsl_vector *direction = gsl_vector_alloc(n);
+    gsl_vector *previous_weights = gsl_vector_alloc(n);
+    // Row k of these holds the k-th stored pair s = w_new - w_old, d = gradient_new - gradient_old
+    gsl_matrix *s_history = gsl_matrix_alloc(history_size, n);
+    gsl_matrix *d_history = gsl_matrix_alloc(history_size, n);
+    double *rho = malloc(history_size*sizeof(double));
+    double *alpha = malloc(history_size*sizeof(double));
+    unsigned int status = 0;
+    if(!z_data||!error_set||!gradient||!new_gradient||!direction||!previous_weights||!s_history||!d_history||!rho||!alpha){
+        status = 1;
+        goto cleanup;
+    }
+
+    size_t stored = 0, newest = 0;
+    double loss = logistic_objective(y_data, x_data, weight_set, options->l2_regularisation, z_data, error_set, gradient);
+    for(unsigned int iteration=0;iteration<options->max_iterations;iteration++){
+        double gradient_norm = gsl_blas_dnrm2(gradient);
+        if(gradient_norm < options->tolerance) break;
+
+        // Two-loop recursion: direction = H * gradient with H the L-BFGS inverse Hessian approximation
+        gsl_vector_memcpy(direction, gradient);
+        for(size_t k=0;k<stored;k++){
+            size_t index = (newest + history_size - k) % history_size;
+            gsl_vector_view s = gsl_matrix_row(s_history, index);
+            gsl_vector_view d = gsl_matrix_row(d_history, index);
+            double dot;
+            gsl_blas_ddot(&s.vector, direction, &dot);
+            alpha[index] = rho[index]*dot;
+            gsl_blas_daxpy(-alpha[index], &d.vector, direction);
+        }
+        if(stored > 0){
+            // Initial Hessian guess gamma*I with gamma = s^T d / d^T d of the newest pair
+            gsl_vector_view s = gsl_matrix_row(s_history, newest);
+            gsl_vector_view d = gsl_matrix_row(d_history, newest);
+            double s_dot_d, d_dot_d;
+            gsl_blas_ddot(&s.vector, &d.vector, &s_dot_d);
+            gsl_blas_ddot(&d.vector, &d.vector, &d_dot_d);
+            gsl_vector_scale(direction, s_dot_d/d_dot_d);
+        }
+        else{
+            // First step: plain gradient descent of length 1
+            gsl_vector_scale(direction, 1.0/gradient_norm);
+        }
+        for(size_t k=stored;k-->0;){
+            size_t index = (newest + history_size - k) % history_size;
+            gsl_vector_view s = gsl_matrix_row(s_history, index);
+            gsl_vector_view d = gsl_matrix_row(d_history, index);
+            double dot;
+            gsl_blas_ddot(&d.vector, direction, &dot);
+            gsl_blas_daxpy(alpha[index] - rho[index]*dot, &s.vector, direction);
+        }
+
+        // Backtracking line search along -direction (Armijo condition)
+        double slope, step_length = 1.0, new_loss = loss;
+        gsl_blas_ddot(gradient, direction, &slope);
+        if(slope <= 0){
+            // Not a descent direction (numerical trouble), restart from the gradient
+            stored = 0;
+            gsl_vector_memcpy(direction, gradient);
+            gsl_vector_scale(direction, 1.0/gradient_norm);
+            slope = gradient_norm;
+        }
+        gsl_vector_memcpy(previous_weights, weight_set);
+        int accepted = 0;
+        for(int halving=0;halving<30;halving++){
+            gsl_vector_memcpy(weight_set, previous_weights);
+            gsl_blas_daxpy(-step_length, direction, weight_set);
+            new_loss = logistic_objective(y_data, x_data, weight_set, options->l2_regularisation, z_data, error_set, new_gradient);
+            if(new_loss <= loss - 1e-4*step_length*slope){
+                accepted = 1;
+                break;
+            }
+            step_length *= 0.5;
+        }
+        if(iterations_run) *iterations_run = iteration+1;
+        if(!accepted){
+            gsl_vector_memcpy(weight_set, previous_weights);
+            break;
+        }
+
+        // Store the new pair, skip it if the curvature s^T d is not positive
+        size_t slot = (stored == 0) ? newest : (newest + 1) % history_size;
+        gsl_vector_view s = gsl_matrix_row(s_history, slot);
+        gsl_vector_view d = gsl_matrix_row(d_history, slot);
+        gsl_vector_memcpy(&s.vector, weight_set);
+        gsl_vector_sub(&s.vector, previous_weights);
+        gsl_vector_memcpy(&d.vector, new_gradient);
+        gsl_vector_sub(&d.vector, gradient);
+        double curvature;
+        gsl_blas_ddot(&s.vector, &d.vector, &curvature);
+        if(curvature > 1e-12){
+            rho[slot] = 1.0/curvature;
+            newest = slot;
+            if(stored < history_size) stored++;
+        }
+        else if(stored == history_size){
+            stored--; // the slot of the oldest pair was overwritten
+        }
+
+        double loss_change = loss - new_loss;
+        loss = new_loss;
+        gsl_vector_memcpy(gradient, new_gradient);
+        if(loss_change <= 1e-15*fabs(loss)) break; // no further progress possible in double precision
+    }
+
+cleanup:
+    if(z_data)gsl_vector_free(z_data);
+    if(error_set)gsl_vector_free(error_set);
+    if(gradient)gsl_vector_free(gradient);
+    if(new_gradient)gsl_vector_free(new_gradient);
+    if(direction)gsl_vector_free(direction);
+    if(previous_weights)gsl_vector_free(previous_weights);
+    if(s_history)gsl_matrix_free(s_history);
+    if(d_history)gsl_matrix_free(d_history);
+    free(rho);
+    free(alpha);
+    return status;
+}
+
+void logistic_hogwild_options_default(LogisticHogwildOptions *options){
+    options->number_of_threads = 1;
+    options->epochs = 10;
+    options->learning_rate = 0.01;
+    options->l2_regularisation = 0.0;
+    options->loss_tolerance = 0.0;
+    options->seed = 0;
+}
+
+// Per thread state of logistic_regression_train_hogwild, kept across epochs
+typedef struct {
+    gsl_vector *y_data;
+    gsl_matrix *x_data;
+    _Atomic double *weights;    // shared by all threads
+    size_t number_of_rows;
+    size_t *order;              // rows of the shard, in this epoch's visiting order
+    gsl_rng *rng;
+    double learning_rate;
+    double l2_regularisation;
+    double loss;                // sum of the per sample losses seen during the epoch
+}LogisticHogwildShard;
+
+/*
+One epoch of plain SGD over the shard, in a fresh random order. Weights are read and written with
+relaxed atomics: no locks and no ordering, an update of another thread may be seen late or be
+overwritten (the Hogwild scheme), but never torn. Zero features are skipped when there is no
+penalty, so sparse rows only touch their own weights.
+ */
+static void *logistic_hogwild_worker(void *argument){
+    LogisticHogwildShard *shard = (LogisticHogwildShard *)argument;
+    size_t n = shard->x_data->size2;
+    double rate = shard->learning_rate, l2 = shard->l2_regularisation;
+
+    for(size_t i=shard->number_of_rows;i>1;i--){
+        size_t j = gsl_rng_uniform_int(shard->rng, i);
+        size_t swap = shard->order[i-1];
+        shard->order[i-1] = shard->order[j];
+        shard->order[j] = swap;
+    }
+
+    double loss = 0; // local so threads do not write to neighbouring shards' cache lines
+    for(size_t k=0;k<shard->number_of_rows;k++){
+        size_t row = shard->order[k];
+        const double *x = shard->x_data->data + row*shard->x_data->tda;
+        double y = gsl_vector_get(shard->y_data, row);
+
+        double z = 0;
+        for(size_t j=0;j<n;j++) z += x[j]*atomic_load_explicit(&shard->weights[j], memory_order_relaxed);
+        loss += softplus(z) - y*z;
+        double error = sigmoid(z) - y;
+
+        for(size_t j=0;j<n;j++){
+            if(x[j] == 0 && l2 == 0) continue;
+            double w = atomic_load_explicit(&shard->weights[j], memory_order_relaxed);
+            atomic_store_explicit(&shard->weights[j], w - rate*(error*x[j] + l2*w), memory_order_relaxed);
+        }
+    }
+    shard->loss = loss;
+    return NULL;
+}
+
+unsigned int logistic_regression_train_hogwild(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticHogwildOptions *options, unsigned int *epochs_run, double *final_loss){
+    size_t m = x_data->size1, n = x_data->size2;
+    unsigned int number_of_threads = options->number_of_threads;
+    if(epochs_run) *epochs_run = 0;
+    if(m == 0 || y_data->size != m || weight_set->size != n) return 2;
+    if(number_of_threads == 0) number_of_threads = 1;
+    if(number_of_threads > m) number_of_threads = (unsigned int)m;
+
+    unsigned int status = 0;
+    _Atomic double *weights = malloc(n*sizeof(_Atomic double));
+    LogisticHogwildShard *shards = calloc(number_of_threads, sizeof(LogisticHogwildShard));
+    pthread_t *threads = malloc(number_of_threads*sizeof(pthread_t));
+    size_t *order = malloc(m*sizeof(size_t));
+    if(!weights||!shards||!threads||!order){
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+    for(size_t j=0;j<n;j++) atomic_init(&weights[j], gsl_vector_get(weight_set, j));
+    for(size_t i=0;i<m;i++) order[i] = i;
+
+    // Disjoint contiguous shards, the first (m % threads) get one extra row; thread t is seeded with seed + t
+    size_t base_size = m/number_of_threads, remainder = m%number_of_threads, offset = 0;
+    for(unsigned int t=0;t<number_of_threads;t++){
+        LogisticHogwildShard *shard = &shards[t];
+        shard->y_data = y_data;
+        shard->x_data = x_data;
+        shard->weights = weights;
+        shard->number_of_rows = base_size + (t < remainder ? 1 : 0);
+        shard->order = order + offset;
+        shard->learning_rate = options->learning_rate;
+        shard->l2_regularisation = options->l2_regularisation;
+        shard->rng = gsl_rng_alloc(gsl_rng_mt19937);
+        if(!shard->rng){
+            status = 1;
+            goto cleanup;
+        }
+        gsl_rng_set(shard->rng, options->seed + t);
+        offset += shard->number_of_rows;
+    }
+
+    double previous_loss = 0;
+    for(unsigned int epoch=0;epoch<options->epochs;epoch++){
+        // Shard 0 is done by the calling thread while the workers run the rest
+        unsigned int started = 1;
+        for(;started<number_of_threads;started++){
+            if(pthread_create(&threads[started], NULL, logistic_hogwild_worker, &shards[started]) != 0) break;
+        }
+        logistic_hogwild_worker(&shards[0]);
+        for(unsigned int t=1;t<started;t++){
+            pthread_join(threads[t], NULL);
+        }
+        if(started != number_of_threads){
+            status = 1;
+            goto cleanup;
+        }
+
+        // Convergence monitor between epochs: mean loss of the samples as they were visited
+        double loss = 0;
+        for(unsigned int t=0;t<number_of_threads;t++) loss += shards[t].loss;
+        loss /= m;
+        if(epochs_run) *epochs_run = epoch + 1;
+        if(final_loss) *final_loss = loss;
+        if(!isfinite(loss)){
+            status = 2; // diverged, the learning rate is too large
+            break;
+        }
+        if(epoch > 0 && options->loss_tolerance > 0 && fabs(previous_loss - loss) < options->loss_tolerance) break;
+        previous_loss = loss;
+    }
+
+    for(size_t j=0;j<n;j++) gsl_vector_set(weight_set, j, atomic_load_explicit(&weights[j], memory_order_relaxed));
+
+cleanup:
+    if(shards){
+        for(unsigned int t=0;t<number_of_threads;t++){
+            if(shards[t].rng)gsl_rng_free(shards[t].rng);
+        }
+    }
+    free(weights);
+    free(shards);
+    free(threads);
+    free(order);
+    return status;
+}
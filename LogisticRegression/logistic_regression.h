@@ -29,6 +29,59 @@
 #include <gsl/gsl_linalg.h>
 // math.h for exponential
 #include <math.h>
+#include "../SparseMatrix/sparse_matrix.h"
+#include "../Telemetry/training_telemetry.h"
+#include "../FeatureScaling/feature_scaling.h"
+
+/*
+ * Accuracy of the vectorised sigmoid kernels:
+ *    - SIGMOID_EXACT uses the C library exp and gives the same results as `sigmoid`
+ *    - SIGMOID_FAST uses SIMD polynomial approximations (within 3 ULP for sigmoid and 5 ULP for
+ *      log-sigmoid, for |z| <= 708)
+ */
+typedef enum {
+SIGMOID_EXACT = 0,
+SIGMOID_FAST = 1
+}SigmoidAccuracy;
+
+/*
+ * Settings of `logistic_regression_train_irls` and `logistic_regression_train_lbfgs`, 
+ * fill with `logistic_solver_options_default` and change what is needed.
+ */
+typedef struct {
+unsigned int max_iterations;    // maximum number of Newton / L-BFGS steps
+double tolerance;               // stop when the norm of the gradient falls below it
+double l2_regularisation;       // λ of the (λ/2)*||w||^2 penalty, 0 disables it
+size_t history_size;            // L-BFGS only: number of stored correction pairs
+}LogisticSolverOptions;
+
+/*
+ * Settings of `logistic_regression_train_hogwild`, fill with `logistic_hogwild_options_default` 
+ * and change what is needed.
+ */
+typedef struct {
+unsigned int number_of_threads; // worker threads, each owns a disjoint shard of the rows
+unsigned int epochs;            // maximum number of passes over the data
+double learning_rate;           // step size of every single sample update
+double l2_regularisation;       // λ of the penalty (λ/2)*||w||^2, 0 disables it
+double loss_tolerance;          // stop when the epoch's mean loss changes by less than it (0 disables)
+unsigned long seed;             // thread t shuffles its shard with a generator seeded with seed + t
+}LogisticHogwildOptions;
+
+/*
+ * Scratch memory of `logistic_regression_train_ws` and `logistic_regression_predict_ws`, created 
+ * once with `logistic_workspace_alloc` for a maximum number of rows and an exact number of 
+ * features. Apart from `accuracy`, its members are internal to the library.
+ */
+typedef struct {
+SigmoidAccuracy accuracy;   // sigmoid kernel of the _ws functions, SIGMOID_EXACT unless the caller changes it
+size_t number_of_data;      // maximum rows
+size_t number_of_features;  // exact features
+gsl_vector *z_data;         // rows
+gsl_vector *y_predicted;    // rows
+gsl_vector *error_set;      // rows
+gsl_vector *gradient;       // features
+}LogisticWorkspace;
 
 
 /*
@@ -56,6 +109,76 @@ double sigmoid(double x);
  *    double result = sigmoid(0.5); // result will be approximately 0.622
  */
 
+/*
+ * Function: softplus
+ */
+
+double softplus(double z);
+/* ----------------------------
+ * Computes log(1 + exp(z)) without overflow for large z. The cross entropy of a sample with 
+ * label y and linear prediction z is softplus(z) - y*z, which is how the models and the cross 
+ * validation compute their losses.
+ * 
+ * Arguments:
+ *    - z: A double, the linear prediction.
+ *
+ * Returns:
+ *    - A double, log(1 + exp(z)).
+ */
+
+
+/*
+ * Function: sigmoid_vector
+ */
+
+void sigmoid_vector(const double *z, double *output, size_t n, SigmoidAccuracy accuracy);
+/* ----------------------------
+ * This function applies the sigmoid function to a whole array:
+ *    output[i] = 1 / (1 + exp(-z[i]))
+ * It is the kernel used by `logistic_regression_train` and `logistic_regression_predict`. It avoids 
+ * the per element calls of a `sigmoid` loop and, with SIGMOID_FAST, is several times faster.
+ *
+ * With SIGMOID_EXACT the results are bit for bit those of `sigmoid`. 
+ * With SIGMOID_FAST, exp is only ever evaluated at -|z| (a value in (0, 1]):
+ *    sigmoid(z) = 1 / (1 + exp(-|z|))             for z >= 0
+ *    sigmoid(z) = exp(-|z|) / (1 + exp(-|z|))     for z < 0
+ * and computed with SIMD instructions (AVX-512 or AVX2, picked at runtime) as 
+ *    exp(t) = 2^k * exp(r),   k = round(t / ln2),   |r| <= ln2 / 2
+ * where exp(r) is a degree 13 polynomial. The result is within 3 ULP of the exact value for 
+ * |z| <= 708. Below z = -708 (where the exact value is under 3.3e-308) it returns 0, above z = 708 it 
+ * returns 1. On CPUs without AVX2 SIGMOID_FAST falls back to SIGMOID_EXACT.
+ *
+ * Arguments:
+ *    - z: A pointer to the `n` input values.
+ *    - output: A pointer to `n` doubles receiving the results, may be the same array as `z`.
+ *    - n: The number of values.
+ *    - accuracy: SIGMOID_EXACT or SIGMOID_FAST.
+ */
+
+
+/*
+ * Function: log_sigmoid_vector
+ */
+
+void log_sigmoid_vector(const double *z, double *output, size_t n, SigmoidAccuracy accuracy);
+/* ----------------------------
+ * This function computes the logarithm of the sigmoid function for a whole array, as needed by the 
+ * log-loss, without ever forming sigmoid(z) (which rounds to 0 or 1 long before its logarithm 
+ * stops being meaningful):
+ *    output[i] = log(sigmoid(z[i])) = min(z[i], 0) - log(1 + exp(-|z[i]|))
+ * Note that log(1 - sigmoid(z)) = log(sigmoid(-z)).
+ *
+ * With SIGMOID_FAST, log(1 + e) is computed with SIMD instructions from the series of 
+ * 2 * atanh(s) = log((1 + s) / (1 - s)) and stays within 5 ULP for |z| <= 708; SIGMOID_EXACT uses 
+ * log1p and exp of the C library.
+ *
+ * Arguments:
+ *    - z: A pointer to the `n` input values.
+ *    - output: A pointer to `n` doubles receiving the results, may be the same array as `z`.
+ *    - n: The number of values.
+ *    - accuracy: SIGMOID_EXACT or SIGMOID_FAST.
+ */
+
 
 /*
  * Function: logistic_regression_train
@@ -160,4 +283,320 @@ unsigned int logistic_regression_predict(gsl_vector *prediction_set, gsl_vector
  */
 
 
+/*
+ * Function: logistic_regression_train_csr
+ */
+
+unsigned int logistic_regression_train_csr(gsl_vector *y_data, CSRMatrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations);
+/* ----------------------------
+ * Same as `logistic_regression_train` for a sparse (CSR) feature matrix, e.g. one-hot or hashed 
+ * features. Both products of an iteration only visit the stored entries, so an iteration costs 
+ * O(nnz + m + n) instead of O(m * n), and the data never has to be expanded into a dense matrix.
+ *
+ * Returns:
+ *    - 0 if training completes successfully.
+ *    - 1 if memory allocation fails.
+ *    - 2 if a dimension does not match.
+ */
+
+
+/*
+ * Function: logistic_regression_predict_csr
+ */
+
+unsigned int logistic_regression_predict_csr(gsl_vector *prediction_set, gsl_vector *weight_set, CSRMatrix *x_data);
+/* ----------------------------
+ * Same as `logistic_regression_predict` for a sparse (CSR) matrix of rows to classify, in O(nnz).
+ *
+ * Returns:
+ *    - 0 if prediction completes successfully.
+ *    - 1 if memory allocation fails.
+ *    - 2 if a dimension does not match.
+ */
+
+/*
+ * Function: logistic_regression_train_float
+ */
+
+unsigned int logistic_regression_train_float(gsl_vector_float *y_data, gsl_matrix_float *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations);
+/* ----------------------------
+ * Same as `logistic_regression_train` for data stored in single precision, which halves the 
+ * bytes read per iteration. Only the storage is single precision: the products, sums, gradient 
+ * and weights are all in double.
+ *
+ * The rows are processed in tiles of 256: the tile is scored (z = X_tile * w), the sigmoid 
+ * kernel is applied to the tile, and the tile is read again while it is still in cache to add 
+ * its share of the gradient. So every row comes from memory once per iteration, instead of 
+ * twice as with the two dgemv passes of the double version.
+ *
+ * Arguments:
+ *    - y_data: A `gsl_vector_float` of the labels (0 or 1).
+ *    - x_data: A `gsl_matrix_float` (m x n) of features.
+ *    - weight_set, learning_rate, iterations: As for `logistic_regression_train` (weights stay 
+ *      in double).
+ *
+ * Returns:
+ *    - 0 if training completes successfully.
+ *    - 1 if memory allocation fails.
+ *    - 2 if a dimension does not match.
+ */
+
+
+/*
+ * Function: logistic_regression_predict_float
+ */
+
+unsigned int logistic_regression_predict_float(gsl_vector_float *prediction_set, gsl_vector *weight_set, gsl_matrix_float *x_data);
+/* ----------------------------
+ * Same as `logistic_regression_predict` for rows stored in single precision; the scores are 
+ * accumulated in double. It needs no scratch memory.
+ *
+ * Returns:
+ *    - 0 if prediction completes successfully.
+ *    - 2 if a dimension does not match.
+ */
+
+/*
+ * Function: logistic_workspace_alloc
+ */
+
+LogisticWorkspace *logistic_workspace_alloc(size_t number_of_data, size_t number_of_features);
+/* ----------------------------
+ * This function allocates a workspace for `logistic_regression_train_ws` and 
+ * `logistic_regression_predict_ws`: 3 * number_of_data + number_of_features doubles. A training 
+ * or serving loop that reuses one workspace does no heap allocation after this call. The 
+ * workspace starts with `accuracy` = SIGMOID_EXACT; setting it to SIGMOID_FAST switches the 
+ * functions using this workspace (and no others) to the fast sigmoid kernel:
+ *    workspace->accuracy = SIGMOID_FAST;
+ *
+ * Arguments:
+ *    - number_of_data: The largest number of rows the workspace will be used with.
+ *    - number_of_features: The number of columns of the data.
+ *
+ * Returns:
+ *    - A pointer to the workspace, to be released with `logistic_workspace_free`.
+ *    - NULL if an allocation failed or a size is 0.
+ */
+
+
+/*
+ * Function: logistic_workspace_free
+ */
+
+void logistic_workspace_free(LogisticWorkspace *workspace);
+/* ----------------------------
+ * This function frees a workspace created by `logistic_workspace_alloc`. NULL is ignored.
+ */
+
+
+/*
+ * Function: logistic_regression_train_ws
+ */
+
+unsigned int logistic_regression_train_ws(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, LogisticWorkspace *workspace);
+/* ----------------------------
+ * Same as `logistic_regression_train`, but with its scratch memory taken from `workspace`, so it 
+ * never allocates. The data may have fewer rows than the workspace was created for. The 
+ * sigmoid kernel is `workspace->accuracy`.
+ *
+ * Returns:
+ *    - 0 if training completes successfully.
+ *    - 2 if the workspace has a different number of features or fewer rows than `x_data`.
+ */
+
+
+/*
+ * Function: logistic_regression_predict_ws
+ */
+
+unsigned int logistic_regression_predict_ws(gsl_vector *prediction_set, gsl_vector *weight_set, gsl_matrix *x_data, LogisticWorkspace *workspace);
+/* ----------------------------
+ * Same as `logistic_regression_predict`, but with its scratch memory taken from `workspace`, so 
+ * it never allocates. Suited to serving loops scoring many batches of up to 
+ * `workspace->number_of_data` rows. The sigmoid kernel is `workspace->accuracy`.
+ *
+ * Returns:
+ *    - 0 if prediction completes successfully.
+ *    - 2 if the workspace has a different number of features or fewer rows than `x_data`.
+ */
+
+/*
+ * Function: logistic_regression_train_instrumented
+ */
+
+unsigned int logistic_regression_train_instrumented(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, TrainingTelemetry *telemetry);
+/* ----------------------------
+ * Same as `logistic_regression_train`, and fills `telemetry` (see [Telemetry](../Telemetry)) with 
+ * the time of the iterations (`TELEMETRY_ITERATIONS`, split into the two matrix-vector products 
+ * `TELEMETRY_PRODUCTS` and the sigmoid, error and update `TELEMETRY_UPDATE`), the number 
+ * performed, the bytes streamed and the allocations made. Every `sample_stride` iterations the mean cross entropy 
+ *    (1/m) * Σ [log(1+exp(z_i)) - y_i*z_i]
+ * and the norm of the gradient (1/m)*X^T(σ(z) - y) at the current weights are recorded and 
+ * passed to the callback. The products are computed by the iteration anyway; the loss needs one 
+ * logarithm and one exponential per row, so a small stride slows training down noticeably. If 
+ * the callback returns non zero, training stops before that iteration changes the weights.
+ *
+ * Returns:
+ *    - As `logistic_regression_train`.
+ *    - 3 if the callback stopped training (`weight_set` holds the last completed iteration).
+ */
+
+/*
+ * Function: logistic_regression_train_scaled
+ */
+
+unsigned int logistic_regression_train_scaled(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, double learning_rate, unsigned int iterations, FeatureScaling *scaling);
+/* ----------------------------
+ * Same as `logistic_regression_train`, but the steps are taken as if every column of `x_data` 
+ * were standardised (see [FeatureScaling](../FeatureScaling)), which converges in far fewer 
+ * iterations when the columns have very different ranges. The data is not copied: the column 
+ * statistics take one pass over the rows and every iteration does the same products as the 
+ * plain one plus O(n) work on the weights and the gradient. `weight_set` is read and returned 
+ * for the original columns, so `logistic_regression_predict` uses it as it is.
+ *
+ * Arguments:
+ *    - y_data, x_data, weight_set, learning_rate, iterations: As for `logistic_regression_train`.
+ *    - scaling: NULL to compute the statistics for this call only, or a FeatureScaling whose 
+ *      `mean` and `deviation` vectors (n entries) receive them, or provide them when `reuse` is set.
+ *
+ * Returns:
+ *    - 0 on success.
+ *    - 1 if an allocation failed.
+ *    - 2 if the sizes of `y_data`, `x_data`, `weight_set` or the scaling vectors do not match, or 
+ *      there are no rows.
+ */
+
+/*
+ * Function: logistic_solver_options_default
+ */
+
+void logistic_solver_options_default(LogisticSolverOptions *options);
+/* ----------------------------
+ * This function fills `options` with the defaults: 100 iterations, gradient tolerance 1e-8, 
+ * no L2 regularisation and an L-BFGS history of 10 pairs.
+ */
+
+
+/*
+ * Function: logistic_regression_train_irls
+ */
+
+unsigned int logistic_regression_train_irls(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticSolverOptions *options, unsigned int *iterations_run);
+/* ----------------------------
+ * This function trains a logistic regression model with **Newton's method**, also known as 
+ * Iteratively Reweighted Least Squares (IRLS). Where gradient descent only uses the slope of the 
+ * loss, Newton's method also uses its curvature and typically converges in 5 to 20 steps instead 
+ * of thousands.
+ *
+ * The minimised loss is the mean negative log likelihood plus an optional L2 penalty:
+ *    f(w) = (1/m) * Σ [log(1 + exp(z_i)) - y_i * z_i] + (λ/2) * ||w||^2,   z = x_data * w
+ * With p = sigmoid(z) its gradient and Hessian are:
+ *    g = (1/m) * X^T * (p - y) + λ * w
+ *    H = (1/m) * X^T * S * X + λ * I,   S = diag(p_i * (1 - p_i))
+ * Every step solves H * d = g using a Cholesky decomposition (as `mlr_train` does for the normal 
+ * equation) and moves to w - t * d, where t starts at 1 and is halved until the loss decreases 
+ * enough (backtracking line search).
+ *
+ * Every step costs O(m * n^2) for H, so this solver is meant for a moderate number of features. 
+ * For many features use `logistic_regression_train_lbfgs`.
+ *
+ * Arguments:
+ *    - y_data: A pointer to a `gsl_vector` containing the true labels (0 or 1).
+ *    - x_data: A pointer to a `gsl_matrix` containing the feature set.
+ *    - weight_set: A pointer to a `gsl_vector` with the starting weights (e.g. zeros), updated in place.
+ *    - options: A pointer to the `LogisticSolverOptions` to use.
+ *    - iterations_run: If not NULL, receives the number of Newton steps taken.
+ *
+ * Returns:
+ *    - `0` if training completed (converged or reached `max_iterations`).
+ *    - `1` if memory allocation fails.
+ *    - `2` if the Hessian could not be decomposed (e.g. perfectly separable data or duplicate columns 
+ *      without regularisation). `weight_set` holds the last accepted weights.
+ *
+ * Notes:
+ *    - With perfectly separable data the unregularised weights grow without bound, set 
+ *      `l2_regularisation` to a small positive value in that case.
+ *    - The penalty also applies to the intercept weight.
+ */
+
+
+/*
+ * Function: logistic_regression_train_lbfgs
+ */
+
+unsigned int logistic_regression_train_lbfgs(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticSolverOptions *options, unsigned int *iterations_run);
+/* ----------------------------
+ * This function minimises the same loss as `logistic_regression_train_irls` with **L-BFGS**, a 
+ * quasi-Newton method. Instead of forming the (n x n) Hessian it remembers the last `history_size` 
+ * steps s = w_new - w_old and gradient changes d = g_new - g_old, and from them builds an 
+ * approximation of the inverse Hessian times the gradient with the two-loop recursion. Memory and 
+ * work per step are O(history_size * n) on top of the two passes over the data for the loss and 
+ * gradient, which makes it suited to wide data.
+ *
+ * Every step is followed by a backtracking line search. Pairs with non positive curvature 
+ * (s^T d <= 0) are skipped so the approximation stays positive definite.
+ *
+ * Arguments:
+ *    - y_data: A pointer to a `gsl_vector` containing the true labels (0 or 1).
+ *    - x_data: A pointer to a `gsl_matrix` containing the feature set.
+ *    - weight_set: A pointer to a `gsl_vector` with the starting weights (e.g. zeros), updated in place.
+ *    - options: A pointer to the `LogisticSolverOptions` to use.
+ *    - iterations_run: If not NULL, receives the number of L-BFGS steps taken.
+ *
+ * Returns:
+ *    - `0` if training completed (converged, stalled at machine precision or reached `max_iterations`).
+ *    - `1` if memory allocation fails.
+ */
+
+
+/*
+ * Function: logistic_hogwild_options_default
+ */
+
+void logistic_hogwild_options_default(LogisticHogwildOptions *options);
+/* ----------------------------
+ * This function fills `options` with the defaults: 1 thread, 10 epochs, learning rate 0.01, no 
+ * regularisation, no early stopping and seed 0.
+ */
+
+
+/*
+ * Function: logistic_regression_train_hogwild
+ */
+
+unsigned int logistic_regression_train_hogwild(gsl_vector *y_data, gsl_matrix *x_data, gsl_vector *weight_set, LogisticHogwildOptions *options, unsigned int *epochs_run, double *final_loss);
+/* ----------------------------
+ * This function trains the logistic regression model with asynchronous, lock free stochastic 
+ * gradient descent ("Hogwild"). The rows are split into one contiguous shard per thread. In every 
+ * epoch each thread visits the rows of its shard in a new random order and, after every single 
+ * row, updates the shared weights:
+ *    w = w - α * ((sigmoid(x^T w) - y) * x + λ*w)
+ * The weights are read and written with relaxed atomic operations and no locks, so threads never 
+ * wait for each other; an update may occasionally overwrite one made at the same time by another 
+ * thread, which SGD tolerates (most of all on sparse data, where rows touch few weights).
+ *
+ * Between epochs the threads are joined and a convergence monitor adds up the loss every thread 
+ * saw during the epoch. Training stops after `epochs` epochs, when the mean loss changes by less 
+ * than `loss_tolerance`, or when the loss is no longer finite.
+ *
+ * Arguments:
+ *    - y_data: A pointer to a `gsl_vector` containing the true labels (0 or 1).
+ *    - x_data: A pointer to a `gsl_matrix` containing the feature set.
+ *    - weight_set: A pointer to a `gsl_vector` with the starting weights, updated at the end.
+ *    - options: A pointer to the `LogisticHogwildOptions` to use.
+ *    - epochs_run: If not NULL, receives the number of epochs performed.
+ *    - final_loss: If not NULL, receives the mean loss of the last epoch.
+ *
+ * Returns:
+ *    - `0` if training completed.
+ *    - `1` if memory allocation or thread creation fails.
+ *    - `2` if a dimension does not match or training diverged (the loss is no longer finite).
+ *
+ * Notes:
+ *    - With one thread the result only depends on the seed. With more threads the interleaving of 
+ *      the updates, and so the exact result, changes from run to run.
+ *    - Link with -pthread.
+ */
+
+
 #endif // LOGISTIC_REGRESSION_H
@@ -0,0 +1,281 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "model_io.h"
+
+// 64-bit FNV-1a, continued from hash
+static uint64_t fnv1a(const void *data, size_t size, uint64_t hash){
+    const unsigned char *bytes = (const unsigned char *)data;
+    for(size_t i=0;i<size;i++){
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+#define FNV1A_OFFSET 0xcbf29ce484222325ULL
+
+static uint64_t align_up(uint64_t value){
+    return (value + MODEL_ALIGNMENT - 1) / MODEL_ALIGNMENT * MODEL_ALIGNMENT;
+}
+
+// Checks everything the header says against the expected type and the size of the file
+static int model_header_valid(const ModelHeader *header, ModelType expected_type, uint64_t file_size){
+    return memcmp(header->magic, MODEL_MAGIC, 4) == 0
+        && header->version == MODEL_VERSION
+        && header->model_type == (uint32_t)expected_type
+        && header->dtype == MODEL_DTYPE_FLOAT64
+        && header->rows > 0 && header->columns > 0
+        && header->parameter_offset >= sizeof(ModelHeader)
+        && header->parameter_offset % MODEL_ALIGNMENT == 0
+        // sizes are checked against overflow before being compared with the file
+        && header->columns <= (UINT64_MAX / sizeof(double)) / header->rows
+        && header->parameter_offset <= file_size
+        && header->rows * header->columns * sizeof(double) <= file_size - header->parameter_offset;
+}
+
+/*
+Writes header and parameters (contiguous, rows x columns) to path + ".tmp", then renames it over
+path, so readers never see a half written file.
+ */
+static unsigned int model_write(const char *path, ModelType type, const double *parameters, size_t rows, size_t columns){
+    ModelHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MODEL_MAGIC, 4);
+    header.version = MODEL_VERSION;
+    header.model_type = (uint32_t)type;
+    header.dtype = MODEL_DTYPE_FLOAT64;
+    header.rows = rows;
+    header.columns = columns;
+    header.parameter_offset = align_up(sizeof(ModelHeader));
+    size_t parameter_bytes = rows*columns*sizeof(double);
+    header.checksum = fnv1a(parameters, parameter_bytes, FNV1A_OFFSET);
+
+    size_t path_length = strlen(path);
+    char *temporary_path = malloc(path_length + 5);
+    if(!temporary_path) return 1; // 1 is for system error
+    memcpy(temporary_path, path, path_length);
+    memcpy(temporary_path + path_length, ".tmp", 5);
+
+    unsigned int status = 1;
+    FILE *file = fopen(temporary_path, "wb");
+    if(file){
+        static const char padding[MODEL_ALIGNMENT] = {0};
+        int written = fwrite(&header, sizeof(header), 1, file) == 1
+                   && fwrite(padding, 1, header.parameter_offset - sizeof(header), file) == header.parameter_offset - sizeof(header)
+                   && fwrite(parameters, sizeof(double), rows*columns, file) == rows*columns
+                   && fflush(file) == 0
+                   && fsync(fileno(file)) == 0;
+        if(fclose(file) == 0 && written && rename(temporary_path, path) == 0) status = 0;
+    }
+    if(status != 0) unlink(temporary_path);
+    free(temporary_path);
+    return status;
+}
+
+/*
+Opens path and checks its header; on success the file is positioned at the parameters.
+ */
+static unsigned int model_open(const char *path, ModelType type, ModelHeader *header, FILE **file){
+    *file = fopen(path, "rb");
+    if(!*file) return 1;
+    struct stat file_status;
+    if(fstat(fileno(*file), &file_status) != 0){
+        fclose(*file);
+        return 1;
+    }
+    if((uint64_t)file_status.st_size < sizeof(ModelHeader)
+       || fread(header, sizeof(ModelHeader), 1, *file) != 1
+       || !model_header_valid(header, type, (uint64_t)file_status.st_size)
+       || fseek(*file, (long)header->parameter_offset, SEEK_SET) != 0){
+        fclose(*file);
+        return 2; // 2 is for an invalid file
+    }
+    return 0;
+}
+
+// Reads the rows x columns parameters into destination and checks them against the header's checksum
+static unsigned int model_read_parameters(FILE *file, ModelHeader *header, double *destination){
+    size_t count = header->rows*header->columns;
+    unsigned int status = 0;
+    if(fread(destination, sizeof(double), count, file) != count) status = 1;
+    else if(fnv1a(destination, count*sizeof(double), FNV1A_OFFSET) != header->checksum) status = 2;
+    fclose(file);
+    return status;
+}
+
+// Parameters of a vector, copied when it is strided
+static unsigned int model_save_vector(const char *path, ModelType type, gsl_vector *vector){
+    if(vector->stride == 1) return model_write(path, type, vector->data, vector->size, 1);
+    double *copy = malloc(vector->size*sizeof(double));
+    if(!copy) return 1;
+    for(size_t i=0;i<vector->size;i++) copy[i] = gsl_vector_get(vector, i);
+    unsigned int status = model_write(path, type, copy, vector->size, 1);
+    free(copy);
+    return status;
+}
+
+static unsigned int model_load_vector(const char *path, ModelType type, gsl_vector **vector){
+    *vector = NULL;
+    ModelHeader header;
+    FILE *file;
+    unsigned int status = model_open(path, type, &header, &file);
+    if(status != 0) return status;
+    if(header.columns != 1){
+        fclose(file);
+        return 2;
+    }
+    gsl_vector *loaded = gsl_vector_alloc(header.rows);
+    if(!loaded){
+        fclose(file);
+        return 1;
+    }
+    status = model_read_parameters(file, &header, loaded->data);
+    if(status != 0){
+        gsl_vector_free(loaded);
+        return status;
+    }
+    *vector = loaded;
+    return 0;
+}
+
+unsigned int model_save_linear(const char *path, LinearRegressionResult *result_set){
+    double parameters[2] = {result_set->slope, result_set->intercept};
+    return model_write(path, MODEL_LINEAR, parameters, 2, 1);
+}
+
+unsigned int model_load_linear(const char *path, LinearRegressionResult *result_set){
+    ModelHeader header;
+    FILE *file;
+    unsigned int status = model_open(path, MODEL_LINEAR, &header, &file);
+    if(status != 0) return status;
+    if(header.rows != 2 || header.columns != 1){
+        fclose(file);
+        return 2;
+    }
+    double parameters[2];
+    status = model_read_parameters(file, &header, parameters);
+    if(status != 0) return status;
+    result_set->slope = parameters[0];
+    result_set->intercept = parameters[1];
+    return 0;
+}
+
+unsigned int model_save_mlr(const char *path, gsl_vector *coeff_set){
+    return model_save_vector(path, MODEL_MLR, coeff_set);
+}
+
+unsigned int model_load_mlr(const char *path, gsl_vector **coeff_set){
+    return model_load_vector(path, MODEL_MLR, coeff_set);
+}
+
+unsigned int model_save_logistic(const char *path, gsl_vector *weight_set){
+    return model_save_vector(path, MODEL_LOGISTIC, weight_set);
+}
+
+unsigned int model_load_logistic(const char *path, gsl_vector **weight_set){
+    return model_load_vector(path, MODEL_LOGISTIC, weight_set);
+}
+
+unsigned int model_save_softmax(const char *path, gsl_matrix *weight_set){
+    size_t rows = weight_set->size1, columns = weight_set->size2;
+    if(weight_set->tda == columns) return model_write(path, MODEL_SOFTMAX, weight_set->data, rows, columns);
+    // Sub-matrix views have padded rows, pack them first
+    double *copy = malloc(rows*columns*sizeof(double));
+    if(!copy) return 1;
+    for(size_t i=0;i<rows;i++) memcpy(copy + i*columns, weight_set->data + i*weight_set->tda, columns*sizeof(double));
+    unsigned int status = model_write(path, MODEL_SOFTMAX, copy, rows, columns);
+    free(copy);
+    return status;
+}
+
+unsigned int model_load_softmax(const char *path, gsl_matrix **weight_set){
+    *weight_set = NULL;
+    ModelHeader header;
+    FILE *file;
+    unsigned int status = model_open(path, MODEL_SOFTMAX, &header, &file);
+    if(status != 0) return status;
+    gsl_matrix *loaded = gsl_matrix_alloc(header.rows, header.columns);
+    if(!loaded){
+        fclose(file);
+        return 1;
+    }
+    status = model_read_parameters(file, &header, loaded->data);
+    if(status != 0){
+        gsl_matrix_free(loaded);
+        return status;
+    }
+    *weight_set = loaded;
+    return 0;
+}
+
+unsigned int model_map(MappedModel *model, const char *path, ModelType expected_type, int verify_checksum){
+    int file = open(path, O_RDONLY);
+    if(file < 0) return 1; // 1 is for system error
+
+    struct stat file_status;
+    if(fstat(file, &file_status) != 0){
+        close(file);
+        return 1;
+    }
+    size_t file_size = (size_t)file_status.st_size;
+    if(file_size < sizeof(ModelHeader)){
+        close(file);
+        return 2; // 2 is for an invalid file
+    }
+
+    // Shared read only mapping: all processes mapping the file share the page cache copy
+    void *mapping = mmap(NULL, file_size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if(mapping == MAP_FAILED) return 1;
+
+    ModelHeader *header = (ModelHeader *)mapping;
+    int valid = model_header_valid(header, expected_type, file_size);
+    double *parameters = (double *)((char *)mapping + (valid ? header->parameter_offset : 0));
+    if(valid && verify_checksum){
+        valid = fnv1a(parameters, header->rows*header->columns*sizeof(double), FNV1A_OFFSET) == header->checksum;
+    }
+    if(!valid){
+        munmap(mapping, file_size);
+        return 2;
+    }
+
+    model->header = *header;
+    model->mapping = mapping;
+    model->mapping_size = file_size;
+    model->parameters = gsl_vector_view_array(parameters, header->rows*header->columns);
+    model->weight_matrix = gsl_matrix_view_array(parameters, header->rows, header->columns);
+    return 0;
+}
+
+void model_unmap(MappedModel *model){
+    if(!model->mapping) return;
+    munmap(model->mapping, model->mapping_size);
+    model->mapping = NULL;
+    model->mapping_size = 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODEL_IO_H
+#define MODEL_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include "../LinearRegression/linear_regression.h"
+
+/*
+ * On-disk layout of a CLearn model file (all values in the byte order of the machine that wrote it):
+ *
+ *   offset 0                 : ModelHeader (64 bytes)
+ *   offset parameter_offset  : rows x columns parameters, row-major (64-byte aligned)
+ *
+ * The parameters of each model type:
+ *   MODEL_LINEAR    2 x 1, slope then intercept
+ *   MODEL_MLR       features x 1, the coeff_set
+ *   MODEL_LOGISTIC  features x 1, the weight_set
+ *   MODEL_SOFTMAX   features x classes, the weight matrix
+ *
+ * The parameter block is stored exactly as GSL keeps it in memory, so `model_map` can use the 
+ * file in place.
+ */
+
+#define MODEL_MAGIC "CLMD"
+#define MODEL_VERSION 1
+#define MODEL_ALIGNMENT 64
+
+typedef enum {
+MODEL_LINEAR = 1,
+MODEL_MLR = 2,
+MODEL_LOGISTIC = 3,
+MODEL_SOFTMAX = 4
+}ModelType;
+
+// Element type of the parameters, only float64 is written so far
+typedef enum {
+MODEL_DTYPE_FLOAT64 = 1
+}ModelDtype;
+
+typedef struct {
+char magic[4];              // "CLMD"
+uint32_t version;           // MODEL_VERSION, also reveals a byte order mismatch
+uint32_t model_type;        // ModelType
+uint32_t dtype;             // ModelDtype
+uint64_t rows;
+uint64_t columns;
+uint64_t parameter_offset;  // byte offset of the parameters
+uint64_t checksum;          // 64-bit FNV-1a hash of the parameter bytes
+uint64_t reserved[2];
+}ModelHeader;
+
+typedef struct {
+ModelHeader header;             // copy of the file's header
+gsl_vector_view parameters;     // all rows x columns parameters as one vector (the coeff_set / weight_set)
+gsl_matrix_view weight_matrix;  // the same parameters as a (rows x columns) matrix
+void *mapping;
+size_t mapping_size;
+}MappedModel;
+
+
+/*
+ * Function: model_save_linear
+ * ----------------------------
+ */
+unsigned int model_save_linear(const char *path, LinearRegressionResult *result_set);
+/* This function writes a trained simple linear regression model to `path`.
+ *
+ * The file is written under a temporary name and renamed over `path` once complete, so a 
+ * process loading or mapping `path` at the same time sees either the old or the new model, 
+ * never a partial one.
+ *
+ * Returns:
+ *    - `0` if the file was written.
+ *    - `1` if the file could not be written or an allocation failed.
+ */
+
+
+/*
+ * Function: model_load_linear
+ * ----------------------------
+ */
+unsigned int model_load_linear(const char *path, LinearRegressionResult *result_set);
+/* This function reads a model written by `model_save_linear` into `result_set`.
+ *
+ * Returns:
+ *    - `0` if the model was read.
+ *    - `1` if the file could not be read.
+ *    - `2` if the file is not a valid linear regression model file (magic, version, type, dtype, 
+ *      size or checksum do not match).
+ */
+
+
+/*
+ * Function: model_save_mlr
+ * ----------------------------
+ */
+unsigned int model_save_mlr(const char *path, gsl_vector *coeff_set);
+/* This function writes the coefficients of a multiple linear regression model to `path`, in the 
+ * same way as `model_save_linear`.
+ *
+ * Returns:
+ *    - `0` if the file was written.
+ *    - `1` if the file could not be written or an allocation failed.
+ */
+
+
+/*
+ * Function: model_load_mlr
+ * ----------------------------
+ */
+unsigned int model_load_mlr(const char *path, gsl_vector **coeff_set);
+/* This function reads a model written by `model_save_mlr` into a new `gsl_vector`, stored in 
+ * `*coeff_set` and to be released with `gsl_vector_free`. On failure `*coeff_set` is NULL.
+ *
+ * Returns:
+ *    - `0` if the model was read.
+ *    - `1` if the file could not be read or an allocation failed.
+ *    - `2` if the file is not a valid multiple linear regression model file.
+ */
+
+
+/*
+ * Function: model_save_logistic
+ * ----------------------------
+ */
+unsigned int model_save_logistic(const char *path, gsl_vector *weight_set);
+/* This function writes the weights of a logistic regression model to `path`, in the same way as 
+ * `model_save_linear`. Return values as for `model_save_mlr`.
+ */
+
+
+/*
+ * Function: model_load_logistic
+ * ----------------------------
+ */
+unsigned int model_load_logistic(const char *path, gsl_vector **weight_set);
+/* This function reads a model written by `model_save_logistic` into a new `gsl_vector`. Return 
+ * values as for `model_load_mlr`.
+ */
+
+
+/*
+ * Function: model_save_softmax
+ * ----------------------------
+ */
+unsigned int model_save_softmax(const char *path, gsl_matrix *weight_set);
+/* This function writes the (features x classes) weight matrix of a softmax regression model to 
+ * `path`, in the same way as `model_save_linear`. Return values as for `model_save_mlr`.
+ */
+
+
+/*
+ * Function: model_load_softmax
+ * ----------------------------
+ */
+unsigned int model_load_softmax(const char *path, gsl_matrix **weight_set);
+/* This function reads a model written by `model_save_softmax` into a new `gsl_matrix`, to be 
+ * released with `gsl_matrix_free`. Return values as for `model_load_mlr`.
+ */
+
+
+/*
+ * Function: model_map
+ * ----------------------------
+ */
+unsigned int model_map(MappedModel *model, const char *path, ModelType expected_type, int verify_checksum);
+/* This function maps a model file into memory and points `model->parameters` and 
+ * `model->weight_matrix` at its parameters, without reading or copying them. The mapping is 
+ * shared and read only: every process mapping the same file uses the same pages of the page 
+ * cache, so a very wide model is in memory once however many serving processes use it, and 
+ * startup costs only the header check.
+ *
+ * Arguments:
+ *    - model: A pointer to the `MappedModel` to fill.
+ *    - path: The model file.
+ *    - expected_type: The model type the caller wants, the file must be of that type.
+ *    - verify_checksum: 1 to hash the parameters and compare with the header (this reads every 
+ *      page of the file once), 0 to trust the file.
+ *
+ * Returns:
+ *    - `0` if the file was mapped.
+ *    - `1` if the file could not be opened or mapped.
+ *    - `2` if the file is not a valid model file of the expected type, or the checksum is wrong.
+ *
+ * Notes:
+ *    - The views are read only: they can be passed to the predict functions, but writing through 
+ *      them (e.g. training with them) crashes the program.
+ *    - The views stay valid until `model_unmap`.
+ */
+
+
+/*
+ * Function: model_unmap
+ * ----------------------------
+ */
+void model_unmap(MappedModel *model);
+/* This function releases a mapping made by `model_map`.
+ */
+
+#endif // MODEL_IO_H
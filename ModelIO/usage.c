@@ -0,0 +1,86 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+// GSL headers necessary for linear algebra with scope to this model
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "model_io.h"
+#include "../LinearRegression/linear_regression.h"
+#include "../MultipleLinearRegression/multiple_linear_regression.h"
+
+int main() {
+    // Simple linear regression: train, save, load
+    double x[5] = {1, 2, 3, 4, 5};
+    double y[5] = {3.1, 4.9, 7.2, 8.8, 11.1};
+    LinearRegressionResult trained, loaded;
+    linear_regression_train(&trained, x, y, 5);
+    unsigned int result = model_save_linear("linear.model", &trained);
+    if (result == 0) result = model_load_linear("linear.model", &loaded);
+    if (result != 0) {
+        printf("Linear model save/load failed with error code: %u\n", result);
+        return 1;
+    }
+    printf("Linear model: slope %.4f, intercept %.4f (loaded %.4f, %.4f)\n", trained.slope, trained.intercept, loaded.slope, loaded.intercept);
+
+    // Multiple linear regression: y = 1 + 2*x1 - x2, with a bias column
+    double x_array[6][3] = {{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 2, 1}, {1, 1, 2}};
+    gsl_matrix *x_data = gsl_matrix_alloc(6, 3);
+    gsl_vector *y_data = gsl_vector_alloc(6);
+    gsl_vector *coeff_set = gsl_vector_alloc(3);
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 3; j++) gsl_matrix_set(x_data, i, j, x_array[i][j]);
+        gsl_vector_set(y_data, i, 1 + 2*x_array[i][1] - x_array[i][2]);
+    }
+    mlr_train(x_data, y_data, coeff_set, 1e-9);
+    result = model_save_mlr("mlr.model", coeff_set);
+    if (result != 0) {
+        printf("Saving the MLR model failed with error code: %u\n", result);
+        return 1;
+    }
+
+    // Map it instead of reading it, as a serving process would, and predict with the mapping
+    MappedModel model;
+    result = model_map(&model, "mlr.model", MODEL_MLR, 1);
+    if (result != 0) {
+        printf("Mapping the MLR model failed with error code: %u\n", result);
+        return 1;
+    }
+    gsl_vector *y_new = gsl_vector_alloc(6);
+    mlr_predict_batch(x_data, y_new, &model.parameters.vector);
+    printf("MLR model with %llu coefficients mapped:\n", (unsigned long long)model.header.rows);
+    for (size_t i = 0; i < 6; i++) {
+        printf("Row %zu: predicted %.4f, true %.4f\n", i, gsl_vector_get(y_new, i), gsl_vector_get(y_data, i));
+    }
+    model_unmap(&model);
+
+    // A file of another model type is refused
+    result = model_map(&model, "linear.model", MODEL_MLR, 0);
+    printf("Mapping the linear model as MLR returns %u\n", result);
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(coeff_set);
+    gsl_vector_free(y_new);
+    return 0;
+}
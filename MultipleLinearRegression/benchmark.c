@@ -0,0 +1,220 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput of the multiple linear regression entry points on synthetic data.
+ * Usage: ./benchmark [-j] [-q] [-r repetitions]
+ *    -j  print the results as JSON, for tracking regressions between versions
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case, the median is reported (default 5)
+ * The data is y = 1 + Σ j*x_j/features + noise with a bias column, at 10^3 to 10^6 rows and 8 or 
+ * 64 features (sizes above 16M values are skipped). See Benchmark/README.md for how the rates 
+ * are defined.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "multiple_linear_regression.h"
+#include "../Benchmark/benchmark_report.h"
+
+// Iterations per refine_mlr_gradient_descent call
+#define BENCHMARK_ITERATIONS 10
+// λ values per mlr_ridge_path call
+#define BENCHMARK_LAMBDAS 100
+// Rows moved per step of the sliding window case
+#define BENCHMARK_SLIDE_ROWS 100
+// Largest rows x features generated
+#define BENCHMARK_MAX_VALUES (1u<<24)
+
+typedef struct {
+gsl_matrix *x_data;
+gsl_vector *y_data;
+gsl_vector *y_new;
+gsl_vector *coeff_set;
+MLRWorkspace *workspace;
+gsl_vector *lambdas;
+gsl_matrix *coeff_path;
+gsl_vector *gcv_scores;
+MLRIncrementalModel *incremental;
+}MLRCase;
+
+static void run_train(void *context){
+    MLRCase *c = context;
+    mlr_train(c->x_data, c->y_data, c->coeff_set, 1e-9);
+}
+
+static void run_train_ws(void *context){
+    MLRCase *c = context;
+    mlr_train_ws(c->x_data, c->y_data, c->coeff_set, 1e-9, c->workspace);
+}
+
+static void run_ridge_path(void *context){
+    MLRCase *c = context;
+    mlr_ridge_path(c->x_data, c->y_data, c->lambdas, c->coeff_path, c->gcv_scores);
+}
+
+// Slides the window by removing its first rows and adding them back at the end, so every repetition starts from the same model
+static void run_incremental_slide(void *context){
+    MLRCase *c = context;
+    gsl_matrix_view x_rows = gsl_matrix_submatrix(c->x_data, 0, 0, BENCHMARK_SLIDE_ROWS, c->x_data->size2);
+    gsl_vector_view y_rows = gsl_vector_subvector(c->y_data, 0, BENCHMARK_SLIDE_ROWS);
+    mlr_incremental_remove(c->incremental, &x_rows.matrix, &y_rows.vector);
+    mlr_incremental_add(c->incremental, &x_rows.matrix, &y_rows.vector);
+    mlr_incremental_solve(c->incremental, c->coeff_set);
+}
+
+static void run_gradient_descent(void *context){
+    MLRCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    refine_mlr_gradient_descent(c->x_data, c->y_data, c->coeff_set, BENCHMARK_ITERATIONS, 0.5);
+}
+
+static void run_gradient_descent_ws(void *context){
+    MLRCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    refine_mlr_gradient_descent_ws(c->x_data, c->y_data, c->coeff_set, BENCHMARK_ITERATIONS, 0.5, c->workspace);
+}
+
+static void run_gradient_descent_scaled(void *context){
+    MLRCase *c = context;
+    gsl_vector_set_zero(c->coeff_set);
+    refine_mlr_gradient_descent_scaled(c->x_data, c->y_data, c->coeff_set, BENCHMARK_ITERATIONS, 0.5, NULL);
+}
+
+static void run_predict(void *context){
+    MLRCase *c = context;
+    mlr_predict(c->x_data, c->y_new, c->coeff_set);
+}
+
+static void run_predict_batch(void *context){
+    MLRCase *c = context;
+    mlr_predict_batch(c->x_data, c->y_new, c->coeff_set);
+}
+
+int main(int argc, char **argv){
+    BenchmarkReport report;
+    if(benchmark_parse_arguments(&report, "multiple_linear_regression", argc, argv) != 0) return 1;
+    size_t row_sizes[] = {1000, 10000, 100000, 1000000};
+    size_t feature_sizes[] = {8, 64};
+    size_t number_of_row_sizes = report.quick ? 2 : 4;
+
+    benchmark_begin(&report);
+    for(size_t r=0;r<number_of_row_sizes;r++){
+        for(size_t f=0;f<2;f++){
+            size_t rows = row_sizes[r], features = feature_sizes[f];
+            if(rows*features > BENCHMARK_MAX_VALUES) continue;
+            MLRCase c;
+            c.x_data = gsl_matrix_alloc(rows, features);
+            c.y_data = gsl_vector_alloc(rows);
+            c.y_new = gsl_vector_alloc(rows);
+            c.coeff_set = gsl_vector_calloc(features);
+            c.workspace = mlr_workspace_alloc(rows, features);
+            c.lambdas = gsl_vector_alloc(BENCHMARK_LAMBDAS);
+            c.coeff_path = gsl_matrix_alloc(BENCHMARK_LAMBDAS, features);
+            c.gcv_scores = gsl_vector_alloc(BENCHMARK_LAMBDAS);
+            c.incremental = mlr_incremental_alloc(features, 1e-9);
+            if(!c.x_data||!c.y_data||!c.y_new||!c.coeff_set||!c.workspace||!c.lambdas||!c.coeff_path||!c.gcv_scores||!c.incremental){
+                fprintf(stderr, "Could not allocate %zu x %zu data\n", rows, features);
+                return 1;
+            }
+            srand(42);
+            for(size_t i=0;i<rows;i++){
+                double y = 1.0;
+                gsl_matrix_set(c.x_data, i, 0, 1.0);
+                for(size_t j=1;j<features;j++){
+                    double value = 2.0*((double)rand()/RAND_MAX - 0.5);
+                    gsl_matrix_set(c.x_data, i, j, value);
+                    y += value*j/features;
+                }
+                gsl_vector_set(c.y_data, i, y + 0.01*((double)rand()/RAND_MAX - 0.5));
+            }
+            // λ from 10^-6 to 10^4
+            for(size_t k=0;k<BENCHMARK_LAMBDAS;k++) gsl_vector_set(c.lambdas, k, 1e-6*pow(10.0, 10.0*k/(BENCHMARK_LAMBDAS - 1)));
+            double m = rows, n = features;
+
+            // Normal equation: X^T X (2mn^2), X^T y (2mn), Cholesky, inverse and product (about n^3)
+            BenchmarkResult result = {"mlr_train", rows, features, 1, 0, 2*m*n*n + 2*m*n + n*n*n, 8*m*n + 8*m};
+            result.seconds = benchmark_time(run_train, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.function = "mlr_train_ws";
+            result.seconds = benchmark_time(run_train_ws, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            // Ridge path: X^T X (mn^2), eigendecomposition (about 9n^3), then 2n^2 per λ
+            result.function = "mlr_ridge_path (100 lambdas)";
+            result.flops = m*n*n + 2*m*n + 9*n*n*n + BENCHMARK_LAMBDAS*(2*n*n + 8*n);
+            result.seconds = benchmark_time(run_ridge_path, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            // Sliding window over all rows, moved by 100 rows: 200 rank-1 rotations (3n^2) and Gram 
+            // updates (n^2 + 2n), then two triangular solves (2n^2); only the moved rows are read
+            mlr_incremental_add(c.incremental, c.x_data, c.y_data);
+            result.function = "mlr_incremental (slide 100 rows)";
+            result.rows = BENCHMARK_SLIDE_ROWS;
+            result.flops = 2*BENCHMARK_SLIDE_ROWS*(4*n*n + 2*n) + 2*n*n;
+            result.bytes = 2*BENCHMARK_SLIDE_ROWS*(8*n + 8);
+            result.seconds = benchmark_time(run_incremental_slide, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.rows = rows;
+
+            // Every iteration: X*beta and X^T*error (4mn), error and update; X is read twice
+            result.function = "refine_mlr_gradient_descent";
+            result.passes = BENCHMARK_ITERATIONS;
+            result.flops = BENCHMARK_ITERATIONS*(4*m*n + m + 2*n);
+            result.bytes = BENCHMARK_ITERATIONS*(16*m*n + 32*m);
+            result.seconds = benchmark_time(run_gradient_descent, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.function = "refine_mlr_gradient_descent_ws";
+            result.seconds = benchmark_time(run_gradient_descent_ws, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            // Plus one pass for the column statistics (3mn)
+            result.function = "refine_mlr_gradient_descent_scaled";
+            result.flops += 3*m*n;
+            result.bytes += 8*m*n;
+            result.seconds = benchmark_time(run_gradient_descent_scaled, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            // Prediction: X*beta, X read once and y written once
+            result.function = "mlr_predict";
+            result.passes = 1;
+            result.flops = 2*m*n;
+            result.bytes = 8*m*n + 8*m;
+            result.seconds = benchmark_time(run_predict, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            result.function = "mlr_predict_batch";
+            result.seconds = benchmark_time(run_predict_batch, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            gsl_matrix_free(c.x_data);
+            gsl_vector_free(c.y_data);
+            gsl_vector_free(c.y_new);
+            gsl_vector_free(c.coeff_set);
+            mlr_workspace_free(c.workspace);
+            gsl_vector_free(c.lambdas);
+            gsl_matrix_free(c.coeff_path);
+            gsl_vector_free(c.gcv_scores);
+            mlr_incremental_free(c.incremental);
+        }
+    }
+    benchmark_end(&report);
+    return 0;
+}
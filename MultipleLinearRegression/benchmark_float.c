@@ -0,0 +1,118 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Accuracy and speed of the single precision path against the double one.
+ * Usage: ./benchmark_float [rows] [features] [iterations]
+ * Runs refine_mlr_gradient_descent on a double copy and refine_mlr_gradient_descent_float on a 
+ * float copy of the same synthetic data, and prints the time, the mean squared error and the 
+ * largest difference between the two sets of coefficients.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "multiple_linear_regression.h"
+
+static double seconds_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+static double mean_squared_error(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set){
+    double total = 0;
+    for(size_t i=0;i<x_data->size1;i++){
+        double prediction = 0;
+        for(size_t j=0;j<x_data->size2;j++) prediction += gsl_matrix_get(x_data, i, j)*gsl_vector_get(coeff_set, j);
+        double error = prediction - gsl_vector_get(y_data, i);
+        total += error*error;
+    }
+    return total/x_data->size1;
+}
+
+int main(int argc, char **argv){
+    size_t rows = (argc > 1) ? strtoul(argv[1], NULL, 10) : 200000;
+    size_t features = (argc > 2) ? strtoul(argv[2], NULL, 10) : 32;
+    unsigned int iterations = (argc > 3) ? (unsigned int)atoi(argv[3]) : 50;
+    if(rows < 1 || features < 2 || iterations < 1){
+        printf("Usage: %s [rows >= 1] [features >= 2] [iterations >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    gsl_matrix *x_data = gsl_matrix_alloc(rows, features);
+    gsl_vector *y_data = gsl_vector_alloc(rows);
+    gsl_matrix_float *x_float = gsl_matrix_float_alloc(rows, features);
+    gsl_vector_float *y_float = gsl_vector_float_alloc(rows);
+    gsl_vector *coeff_double = gsl_vector_calloc(features);
+    gsl_vector *coeff_float = gsl_vector_calloc(features);
+    if(!x_data||!y_data||!x_float||!y_float||!coeff_double||!coeff_float){
+        printf("Could not allocate %zu x %zu data\n", rows, features);
+        return 1;
+    }
+
+    // y = 1 + Σ j*x_j/features + noise, bias in column 0
+    srand(42);
+    for(size_t i=0;i<rows;i++){
+        double y = 1.0;
+        gsl_matrix_set(x_data, i, 0, 1.0);
+        for(size_t j=1;j<features;j++){
+            double value = 2.0*((double)rand()/RAND_MAX - 0.5);
+            gsl_matrix_set(x_data, i, j, value);
+            y += value*j/features;
+        }
+        gsl_vector_set(y_data, i, y + 0.01*((double)rand()/RAND_MAX - 0.5));
+    }
+    for(size_t i=0;i<rows;i++){
+        for(size_t j=0;j<features;j++) gsl_matrix_float_set(x_float, i, j, (float)gsl_matrix_get(x_data, i, j));
+        gsl_vector_float_set(y_float, i, (float)gsl_vector_get(y_data, i));
+    }
+
+    double start = seconds_now();
+    refine_mlr_gradient_descent(x_data, y_data, coeff_double, iterations, 0.5);
+    double double_time = seconds_now() - start;
+    start = seconds_now();
+    refine_mlr_gradient_descent_float(x_float, y_float, coeff_float, iterations, 0.5);
+    double float_time = seconds_now() - start;
+
+    double largest_difference = 0;
+    for(size_t j=0;j<features;j++){
+        double difference = fabs(gsl_vector_get(coeff_double, j) - gsl_vector_get(coeff_float, j));
+        if(difference > largest_difference) largest_difference = difference;
+    }
+
+    printf("rows: %zu, features: %zu, iterations: %u\n", rows, features, iterations);
+    printf("%-8s %10s %14s %12s %14s\n", "storage", "time (s)", "rows/s", "data (MB)", "MSE");
+    printf("%-8s %10.3f %14.3e %12.1f %14.6e\n", "double", double_time, (double)rows*iterations/double_time,
+           rows*features*sizeof(double)/1e6, mean_squared_error(x_data, y_data, coeff_double));
+    printf("%-8s %10.3f %14.3e %12.1f %14.6e\n", "float", float_time, (double)rows*iterations/float_time,
+           rows*features*sizeof(float)/1e6, mean_squared_error(x_data, y_data, coeff_float));
+    printf("speedup: %.2fx, largest coefficient difference: %.3e\n", double_time/float_time, largest_difference);
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_matrix_float_free(x_float);
+    gsl_vector_float_free(y_float);
+    gsl_vector_free(coeff_double);
+    gsl_vector_free(coeff_float);
+    return 0;
+}
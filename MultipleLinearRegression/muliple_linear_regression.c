@@ -25,16 +25,72 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
 
 // Header link
 #include "multiple_linear_regression.h"
 
+// SIMD kernels are only built for x86 with GCC/Clang, which can compile them per function and check the CPU at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MLR_X86_DISPATCH
+#endif
+
+// Up to this many features mlr_predict_batch uses its own row kernels instead of gsl_blas_dgemv
+#define MLR_SMALL_FEATURE_COUNT 16
+
+// A downdate leaving less than this fraction of a squared diagonal entry of R is ill-conditioned
+#define MLR_DOWNDATE_TOLERANCE 1e-8
+
+/*
+Solves the normal equation (x_trans_x + λI) * coeff_set = x_trans_y, destroying x_trans_x
+telemetry may be NULL
+ */
+static unsigned int mlr_solve_normal_equation(gsl_matrix *x_trans_x, gsl_vector *x_trans_y, gsl_vector *coeff_set, double regularisation_param, TrainingTelemetry *telemetry){
+    double start = telemetry ? telemetry_now() : 0;
+    // doing ridge regularisation to eliminate chances of singularity for which invertion and decomposition may fail 
+    for (size_t i = 0; i < x_trans_x->size1; i++) {
+        gsl_matrix_set(x_trans_x, i, i, gsl_matrix_get(x_trans_x, i, i) + regularisation_param);
+    }
+
+    int decompose_status = gsl_linalg_cholesky_decomp(x_trans_x);  // Cholesky decomposition of X^T * X
+    if(telemetry) start = telemetry_lap(telemetry, TELEMETRY_CHOLESKY, start);
+    
+    if(decompose_status!=GSL_SUCCESS)return 2; // 2 is for arithmatic error
+
+    gsl_linalg_cholesky_invert(x_trans_x);  // Invert x_trans_x
+
+    //Update coeff set by solving (x_trans_x)^-1 * (x_trans_y)
+    gsl_blas_dgemv(CblasNoTrans, 1.0, x_trans_x, x_trans_y, 0.0, coeff_set); 
+    if(telemetry) telemetry_lap(telemetry, TELEMETRY_SOLVE, start);
+    return 0; //No errors
+}
 
 /*
 x_data -> X
 y_data -> Y
 coeff_set -> beta
+x_trans_x (p x p) and x_trans_y (p) are scratch space, overwritten
+telemetry may be NULL
  */
+static unsigned int mlr_train_into(gsl_matrix *x_data,gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, gsl_matrix *x_trans_x, gsl_vector *x_trans_y, TrainingTelemetry *telemetry){
+    double start = telemetry ? telemetry_now() : 0;
+    // x_trans_x=(x_data^t)(x_data)
+    gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, x_data, x_data, 0.0, x_trans_x);
+    // x_trans_y=(x_data^t)(y_data)
+    gsl_blas_dgemv(CblasTrans, 1.0, x_data, y_data, 0.0, x_trans_y);
+    if(telemetry) telemetry_lap(telemetry, TELEMETRY_GRAM, start);
+    return mlr_solve_normal_equation(x_trans_x, x_trans_y, coeff_set, regularisation_param, telemetry);
+}
+
 unsigned int mlr_train(gsl_matrix *x_data,gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param){
 
     //Allocating required local scoped vectors and matrices
@@ -46,29 +102,156 @@ unsigned int mlr_train(gsl_matrix *x_data,gsl_vector *y_data, gsl_vector *coeff_
         if(x_trans_y)gsl_vector_free(x_trans_y);        
         return 1;
         } // 1 is for system error
-    // x_trans_x=(x_data^t)(x_data)
-    gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, x_data, x_data, 0.0, x_trans_x);
-    // x_trans_y=(x_data^t)(y_data)
-    gsl_blas_dgemv(CblasTrans, 1.0, x_data, y_data, 0.0, x_trans_y);
-   
-    // doing ridge regularisation to eliminate chances of singularity for which invertion and decomposition may fail 
-    for (size_t i = 0; i < x_trans_x->size1; i++) {
-        gsl_matrix_set(x_trans_x, i, i, gsl_matrix_get(x_trans_x, i, i) + regularisation_param);
-    }
 
-    int decompose_status = gsl_linalg_cholesky_decomp(x_trans_x);  // Cholesky decomposition of X^T * X
-    
-    if(decompose_status!=GSL_SUCCESS)return 2; // 2 is for arithmatic error
+    unsigned int status = mlr_train_into(x_data, y_data, coeff_set, regularisation_param, x_trans_x, x_trans_y, NULL);
 
-    gsl_linalg_cholesky_invert(x_trans_x);  // Invert x_trans_x
+    // Free allocated memory (also when the decomposition failed)
+    gsl_vector_free(x_trans_y);
+    gsl_matrix_free(x_trans_x);
+    return status;
+}
 
-    //Update coeff set by solving (x_trans_x)^-1 * (x_trans_y)
-    gsl_blas_dgemv(CblasNoTrans, 1.0, x_trans_x, x_trans_y, 0.0, coeff_set); 
+unsigned int mlr_train_instrumented(gsl_matrix *x_data,gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, TrainingTelemetry *telemetry){
+    telemetry_reset(telemetry);
+    double m = x_data->size1, n = x_data->size2;
+    gsl_matrix *x_trans_x = gsl_matrix_alloc(x_data->size2, x_data->size2);
+    gsl_vector *x_trans_y = gsl_vector_alloc(x_data->size2);
+    telemetry->allocations = 2;
+    if(!x_trans_x||!x_trans_y) {
+        if(x_trans_x)gsl_matrix_free(x_trans_x);
+        if(x_trans_y)gsl_vector_free(x_trans_y);
+        return 1;
+        } // 1 is for system error
+
+    unsigned int status = mlr_train_into(x_data, y_data, coeff_set, regularisation_param, x_trans_x, x_trans_y, telemetry);
+    // X is read by both products, X^T X is written, factorised and inverted in place
+    telemetry->bytes_touched = (unsigned long long)(16*m*n + 8*m + 24*n*n);
 
-    // Free allocated memory
     gsl_vector_free(x_trans_y);
     gsl_matrix_free(x_trans_x);
-    return 0; //No errors
+    return status;
+}
+
+/*
+X^T X = V D V^T once, then for every λ with c = V^T X^T y:
+  β(λ) = V * (c_i/(d_i + λ))
+  ||y - Xβ||^2 = y^T y - 2 β^T X^T y + β^T X^T X β = y^T y - Σ c_i^2 (d_i + 2λ)/(d_i + λ)^2
+  df(λ) = trace(X (X^T X + λI)^-1 X^T) = Σ d_i/(d_i + λ)
+ */
+unsigned int mlr_ridge_path(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *lambdas, gsl_matrix *coeff_path, gsl_vector *gcv_scores){
+    size_t m = x_data->size1, n = x_data->size2, number_of_lambdas = lambdas->size;
+    if(y_data->size != m || coeff_path->size1 != number_of_lambdas || coeff_path->size2 != n) return 2;
+    if(gcv_scores && gcv_scores->size != number_of_lambdas) return 2;
+    for(size_t k=0;k<number_of_lambdas;k++){
+        if(!(gsl_vector_get(lambdas, k) >= 0)) return 2; // 2 is for arithmatic error
+    }
+
+    unsigned int status = 0;
+    gsl_matrix *x_trans_x = gsl_matrix_alloc(n, n);
+    gsl_matrix *eigenvectors = gsl_matrix_alloc(n, n);
+    gsl_vector *eigenvalues = gsl_vector_alloc(n);
+    gsl_vector *x_trans_y = gsl_vector_alloc(n);
+    gsl_vector *projected = gsl_vector_alloc(n);
+    gsl_vector *scaled = gsl_vector_alloc(n);
+    gsl_eigen_symmv_workspace *eigen_workspace = gsl_eigen_symmv_alloc(n);
+    if(!x_trans_x||!eigenvectors||!eigenvalues||!x_trans_y||!projected||!scaled||!eigen_workspace){
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    // The only passes over the data
+    gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, x_data, 0.0, x_trans_x);
+    gsl_blas_dgemv(CblasTrans, 1.0, x_data, y_data, 0.0, x_trans_y);
+    double y_squared;
+    gsl_blas_ddot(y_data, y_data, &y_squared);
+
+    // dsyrk only fills the lower triangle
+    for(size_t i=0;i<n;i++){
+        for(size_t j=0;j<i;j++) gsl_matrix_set(x_trans_x, j, i, gsl_matrix_get(x_trans_x, i, j));
+    }
+    if(gsl_eigen_symmv(x_trans_x, eigenvalues, eigenvectors, eigen_workspace) != GSL_SUCCESS){
+        status = 2;
+        goto cleanup;
+    }
+    gsl_blas_dgemv(CblasTrans, 1.0, eigenvectors, x_trans_y, 0.0, projected);
+    // X^T X is positive semi-definite, negative eigenvalues are rounding noise
+    for(size_t i=0;i<n;i++){
+        if(gsl_vector_get(eigenvalues, i) < 0) gsl_vector_set(eigenvalues, i, 0.0);
+    }
+
+    for(size_t k=0;k<number_of_lambdas;k++){
+        double lambda = gsl_vector_get(lambdas, k);
+        double explained = 0, degrees_of_freedom = 0;
+        for(size_t i=0;i<n;i++){
+            double d = gsl_vector_get(eigenvalues, i), c = gsl_vector_get(projected, i);
+            if(d + lambda <= 0){
+                status = 2; // singular for this λ
+                goto cleanup;
+            }
+            double inverse = 1.0/(d + lambda);
+            gsl_vector_set(scaled, i, c*inverse);
+            explained += c*c*(d + 2*lambda)*inverse*inverse;
+            degrees_of_freedom += d*inverse;
+        }
+        gsl_vector_view coefficients = gsl_matrix_row(coeff_path, k);
+        gsl_blas_dgemv(CblasNoTrans, 1.0, eigenvectors, scaled, 0.0, &coefficients.vector);
+        if(gcv_scores){
+            double residual = y_squared - explained;
+            if(residual < 0) residual = 0;
+            double denominator = 1.0 - degrees_of_freedom/m;
+            gsl_vector_set(gcv_scores, k, (denominator > 0) ? (residual/m)/(denominator*denominator) : INFINITY);
+        }
+    }
+
+cleanup:
+    if(x_trans_x)gsl_matrix_free(x_trans_x);
+    if(eigenvectors)gsl_matrix_free(eigenvectors);
+    if(eigenvalues)gsl_vector_free(eigenvalues);
+    if(x_trans_y)gsl_vector_free(x_trans_y);
+    if(projected)gsl_vector_free(projected);
+    if(scaled)gsl_vector_free(scaled);
+    if(eigen_workspace)gsl_eigen_symmv_free(eigen_workspace);
+    return status;
+}
+
+/*
+gradient (p), prediction_set and error_set (m each) are scratch space, overwritten
+telemetry may be NULL; returns 3 if its callback stops training
+With telemetry the two products go to TELEMETRY_PRODUCTS and the error and update to TELEMETRY_UPDATE, sampling is in neither
+ */
+static unsigned int mlr_gradient_descent_into(gsl_matrix*x_data,gsl_vector *y_data,gsl_vector *coeff_set, unsigned int iterations,double learning_rate, gsl_vector *gradient, gsl_vector *prediction_set, gsl_vector *error_set, TrainingTelemetry *telemetry){
+    size_t m = x_data->size1; // number of data
+
+    for(unsigned int i=0;i<iterations;i++){
+        double lap = telemetry ? telemetry_now() : 0;
+        //populate prediction_set = x_data*coeff_set
+        gsl_blas_dgemv(CblasNoTrans,1,x_data,coeff_set,0,prediction_set);
+        if(telemetry) lap = telemetry_lap(telemetry, TELEMETRY_PRODUCTS, lap);
+
+        // Calculate error_set = prediction_set - y_data
+        gsl_vector_memcpy(error_set,prediction_set);
+        gsl_vector_sub(error_set,y_data);
+        if(telemetry) lap = telemetry_lap(telemetry, TELEMETRY_UPDATE, lap);
+
+        //gradient = 1/(number of data) * x_dataTranspose*error_set
+        // In actual formula its 2/m but here 1 is taken for scaling
+        gsl_blas_dgemv(CblasTrans,1.0/m,x_data,error_set,0,gradient);
+        if(telemetry) telemetry_lap(telemetry, TELEMETRY_PRODUCTS, lap);
+
+        if(telemetry && telemetry->sample_stride && i % telemetry->sample_stride == 0){
+            double squared_error;
+            gsl_blas_ddot(error_set, error_set, &squared_error);
+            if(telemetry_record(telemetry, i, squared_error/m, gsl_blas_dnrm2(gradient))) return 3;
+        }
+
+        lap = telemetry ? telemetry_now() : 0;
+        // coeff_set = coeff_set - learning_rate*gradient
+        gsl_blas_daxpy(-learning_rate,gradient,coeff_set);
+        if(telemetry) telemetry_lap(telemetry, TELEMETRY_UPDATE, lap);
+        if(telemetry) telemetry->iterations = i + 1;
+
+    }
+    return 0;
 }
 
 unsigned int refine_mlr_gradient_descent(gsl_matrix*x_data,gsl_vector *y_data,gsl_vector *coeff_set, unsigned int iterations,double learning_rate){
@@ -87,32 +270,710 @@ unsigned int refine_mlr_gradient_descent(gsl_matrix*x_data,gsl_vector *y_data,gs
         return 1;
         } // 1 is for system error
 
-    for(int i=0;i<iterations;i++){
-        //populate prediction_set = x_data*coeff_set
-        gsl_blas_dgemv(CblasNoTrans,1,x_data,coeff_set,0,prediction_set);
+    mlr_gradient_descent_into(x_data, y_data, coeff_set, iterations, learning_rate, gradient, prediction_set, error_set, NULL);
 
-        // Calculate error_set = prediction_set - y_data
-        gsl_vector_memcpy(error_set,prediction_set);
-        gsl_vector_sub(error_set,y_data);
+    // Free allocated memory
+    gsl_vector_free(gradient);
+    gsl_vector_free(prediction_set);
+    gsl_vector_free(error_set);
 
-        //gradient = 1/(number of data) * x_dataTranspose*error_set
-        // In actual formula its 2/m but here 1 is taken for scaling
+    return 0; //No errors
+
+}
+
+unsigned int refine_mlr_gradient_descent_instrumented(gsl_matrix*x_data,gsl_vector *y_data,gsl_vector *coeff_set, unsigned int iterations,double learning_rate, TrainingTelemetry *telemetry){
+    telemetry_reset(telemetry);
+    double m = x_data->size1, n = x_data->size2;
+    gsl_vector *gradient = gsl_vector_alloc(x_data->size2);
+    gsl_vector *prediction_set = gsl_vector_alloc(x_data->size1);
+    gsl_vector *error_set = gsl_vector_alloc(x_data->size1);
+    telemetry->allocations = 3;
+    if(!gradient||!prediction_set||!error_set) {
+        if(gradient)gsl_vector_free(gradient);
+        if(prediction_set)gsl_vector_free(prediction_set);
+        if(error_set)gsl_vector_free(error_set);
+        return 1;
+        } // 1 is for system error
+
+    double start = telemetry_now();
+    unsigned int status = mlr_gradient_descent_into(x_data, y_data, coeff_set, iterations, learning_rate, gradient, prediction_set, error_set, telemetry);
+    telemetry_lap(telemetry, TELEMETRY_ITERATIONS, start);
+    // Every iteration reads X twice and streams the m-vectors prediction, y and error
+    unsigned int passes = telemetry->iterations + (status == 3);
+    telemetry->bytes_touched = (unsigned long long)(passes*(16*m*n + 32*m));
+
+    gsl_vector_free(gradient);
+    gsl_vector_free(prediction_set);
+    gsl_vector_free(error_set);
+    return status;
+}
+
+unsigned int refine_mlr_gradient_descent_scaled(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate, FeatureScaling *scaling){
+    size_t n = x_data->size2; // number of features
+    size_t m = x_data->size1; // number of data
+    if(m==0||y_data->size!=m||coeff_set->size!=n)return 2;
+
+    FeatureScaling local = {0}, *statistics = NULL;
+    double constant_value = 1;
+    gsl_vector *scaled_set = gsl_vector_alloc(n);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    unsigned int status = 1; // 1 is for system error
+    if(!scaled_set||!gradient||!error_set)goto cleanup;
+    status = feature_scaling_prepare(x_data, scaling, &local, &statistics, &constant_value);
+    if(status!=0)goto cleanup;
+
+    // The steps are taken on the standardised coefficients; coeff_set always holds the same model 
+    // for the original columns, so the products use x_data as it is
+    feature_scaling_to_scaled(statistics, constant_value, coeff_set, scaled_set);
+    for(unsigned int i=0;i<iterations;i++){
+        // error_set = x_data*coeff_set - y_data
+        gsl_vector_memcpy(error_set,y_data);
+        gsl_blas_dgemv(CblasNoTrans,1,x_data,coeff_set,-1,error_set);
+
+        // gradient = 1/(number of data) * x_dataTranspose*error_set, then for the standardised columns
         gsl_blas_dgemv(CblasTrans,1.0/m,x_data,error_set,0,gradient);
+        feature_scaling_gradient(statistics, constant_value, gradient);
 
-        // coeff_set = coeff_set - learning_rate*gradient
-        gsl_blas_daxpy(-learning_rate,gradient,coeff_set);
+        gsl_blas_daxpy(-learning_rate,gradient,scaled_set);
+        feature_scaling_from_scaled(statistics, constant_value, scaled_set, coeff_set);
+    }
 
+cleanup:
+    if(local.mean)gsl_vector_free(local.mean);
+    if(local.deviation)gsl_vector_free(local.deviation);
+    if(scaled_set)gsl_vector_free(scaled_set);
+    if(gradient)gsl_vector_free(gradient);
+    if(error_set)gsl_vector_free(error_set);
+    return status;
+}
+
+MLRWorkspace *mlr_workspace_alloc(size_t number_of_data, size_t number_of_features){
+    if(number_of_data==0||number_of_features==0)return NULL;
+    MLRWorkspace *workspace = calloc(1, sizeof(MLRWorkspace));
+    if(!workspace)return NULL;
+    workspace->number_of_data = number_of_data;
+    workspace->number_of_features = number_of_features;
+    workspace->x_trans_x = gsl_matrix_alloc(number_of_features, number_of_features);
+    workspace->x_trans_y = gsl_vector_alloc(number_of_features);
+    workspace->gradient = gsl_vector_alloc(number_of_features);
+    workspace->prediction_set = gsl_vector_alloc(number_of_data);
+    workspace->error_set = gsl_vector_alloc(number_of_data);
+    if(!workspace->x_trans_x||!workspace->x_trans_y||!workspace->gradient||!workspace->prediction_set||!workspace->error_set){
+        mlr_workspace_free(workspace);
+        return NULL;
     }
+    return workspace;
+}
+
+void mlr_workspace_free(MLRWorkspace *workspace){
+    if(!workspace)return;
+    if(workspace->x_trans_x)gsl_matrix_free(workspace->x_trans_x);
+    if(workspace->x_trans_y)gsl_vector_free(workspace->x_trans_y);
+    if(workspace->gradient)gsl_vector_free(workspace->gradient);
+    if(workspace->prediction_set)gsl_vector_free(workspace->prediction_set);
+    if(workspace->error_set)gsl_vector_free(workspace->error_set);
+    free(workspace);
+}
+
+// The data must have exactly the workspace's features and at most its rows
+static int mlr_workspace_fits(MLRWorkspace *workspace, gsl_matrix *x_data){
+    return workspace && x_data->size2 == workspace->number_of_features && x_data->size1 <= workspace->number_of_data;
+}
+
+unsigned int mlr_train_ws(gsl_matrix *x_data,gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, MLRWorkspace *workspace){
+    if(!mlr_workspace_fits(workspace, x_data))return 2; // 2 is for arithmatic error
+    return mlr_train_into(x_data, y_data, coeff_set, regularisation_param, workspace->x_trans_x, workspace->x_trans_y, NULL);
+}
+
+unsigned int refine_mlr_gradient_descent_ws(gsl_matrix*x_data,gsl_vector *y_data,gsl_vector *coeff_set, unsigned int iterations,double learning_rate, MLRWorkspace *workspace){
+    if(!mlr_workspace_fits(workspace, x_data))return 2; // 2 is for arithmatic error
+    // Views over the first m entries, so fewer rows than the workspace was sized for still allocate nothing
+    gsl_vector_view prediction_set = gsl_vector_subvector(workspace->prediction_set, 0, x_data->size1);
+    gsl_vector_view error_set = gsl_vector_subvector(workspace->error_set, 0, x_data->size1);
+    mlr_gradient_descent_into(x_data, y_data, coeff_set, iterations, learning_rate, workspace->gradient, &prediction_set.vector, &error_set.vector, NULL);
+    return 0; //No errors
+}
 
+void mlr_predict(gsl_matrix *x_new,gsl_vector *y_new,gsl_vector *coeff_set){
+    gsl_blas_dgemv(CblasNoTrans,1.0,x_new,coeff_set,1.0,y_new);
+}
+
+/*
+Row-batched kernels for narrow models: the coefficients are kept in registers (or a small local
+array) and 4 rows are scored per step so independent sums can be in flight at the same time.
+x points to the first row, rows are row_stride doubles apart (gsl_matrix tda).
+ */
+static void mlr_predict_rows_scalar(const double *x, size_t row_stride, size_t rows, size_t features, const double *coeff, double *y, size_t y_stride){
+    size_t i = 0;
+    for(;i+4<=rows;i+=4){
+        const double *row0 = x + i*row_stride,
+                     *row1 = row0 + row_stride,
+                     *row2 = row1 + row_stride,
+                     *row3 = row2 + row_stride;
+        double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+        for(size_t j=0;j<features;j++){
+            sum0 += row0[j]*coeff[j];
+            sum1 += row1[j]*coeff[j];
+            sum2 += row2[j]*coeff[j];
+            sum3 += row3[j]*coeff[j];
+        }
+        y[i*y_stride] = sum0;
+        y[(i+1)*y_stride] = sum1;
+        y[(i+2)*y_stride] = sum2;
+        y[(i+3)*y_stride] = sum3;
+    }
+    for(;i<rows;i++){
+        const double *row = x + i*row_stride;
+        double sum = 0;
+        for(size_t j=0;j<features;j++) sum += row[j]*coeff[j];
+        y[i*y_stride] = sum;
+    }
+}
+
+#ifdef MLR_X86_DISPATCH
+__attribute__((target("avx2,fma")))
+static void mlr_predict_rows_avx2(const double *x, size_t row_stride, size_t rows, size_t features, const double *coeff, double *y, size_t y_stride){
+    // coeff is zero padded to MLR_SMALL_FEATURE_COUNT, so whole chunks of 4 can be loaded
+    size_t chunks = (features+3)/4;
+    __m256d coeff_chunk[MLR_SMALL_FEATURE_COUNT/4];
+    for(size_t k=0;k<chunks;k++) coeff_chunk[k] = _mm256_loadu_pd(coeff+4*k);
+
+    // The last chunk of a row may be partial, it is loaded with a mask so we never read past the row
+    size_t tail = features%4;
+    __m256i tail_mask = _mm256_setr_epi64x(-1, (tail==0||tail>1) ? -1 : 0, (tail==0||tail>2) ? -1 : 0, (tail==0) ? -1 : 0);
+
+    size_t i = 0;
+    for(;i+4<=rows;i+=4){
+        __m256d sum[4];
+        for(size_t r=0;r<4;r++){
+            const double *row = x + (i+r)*row_stride;
+            __m256d acc = _mm256_setzero_pd();
+            size_t k = 0;
+            for(;k+1<chunks;k++) acc = _mm256_fmadd_pd(_mm256_loadu_pd(row+4*k), coeff_chunk[k], acc);
+            acc = _mm256_fmadd_pd(_mm256_maskload_pd(row+4*k, tail_mask), coeff_chunk[k], acc);
+            sum[r] = acc;
+        }
+        // Horizontal reduction of the 4 accumulators into one vector {y_i, y_i+1, y_i+2, y_i+3}
+        __m256d pair01 = _mm256_hadd_pd(sum[0], sum[1]);
+        __m256d pair23 = _mm256_hadd_pd(sum[2], sum[3]);
+        __m128d total01 = _mm_add_pd(_mm256_castpd256_pd128(pair01), _mm256_extractf128_pd(pair01, 1));
+        __m128d total23 = _mm_add_pd(_mm256_castpd256_pd128(pair23), _mm256_extractf128_pd(pair23, 1));
+        if(y_stride == 1){
+            _mm_storeu_pd(y+i, total01);
+            _mm_storeu_pd(y+i+2, total23);
+        }
+        else{
+            _mm_storel_pd(y+i*y_stride, total01);
+            _mm_storeh_pd(y+(i+1)*y_stride, total01);
+            _mm_storel_pd(y+(i+2)*y_stride, total23);
+            _mm_storeh_pd(y+(i+3)*y_stride, total23);
+        }
+    }
+    mlr_predict_rows_scalar(x+i*row_stride, row_stride, rows-i, features, coeff, y+i*y_stride, y_stride);
+}
+#endif
+
+void mlr_predict_batch(gsl_matrix *x_new, gsl_vector *y_new, gsl_vector *coeff_set){
+    size_t features = x_new->size2;
+    if(features > MLR_SMALL_FEATURE_COUNT || features == 0){
+        // Wide rows are already efficient in BLAS
+        gsl_blas_dgemv(CblasNoTrans, 1.0, x_new, coeff_set, 0.0, y_new);
+        return;
+    }
+
+    // Contiguous, zero padded copy of the coefficients (coeff_set may be a strided view)
+    double coeff[MLR_SMALL_FEATURE_COUNT] = {0};
+    for(size_t j=0;j<features;j++) coeff[j] = gsl_vector_get(coeff_set, j);
+
+#ifdef MLR_X86_DISPATCH
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        mlr_predict_rows_avx2(x_new->data, x_new->tda, x_new->size1, features, coeff, y_new->data, y_new->stride);
+        return;
+    }
+#endif
+    mlr_predict_rows_scalar(x_new->data, x_new->tda, x_new->size1, features, coeff, y_new->data, y_new->stride);
+}
+
+long mlr_file_block_reader(gsl_matrix *x_block, gsl_vector *y_block, void *reader_context){
+    FILE *file = (FILE *)reader_context;
+    size_t features = x_block->size2;
+    long rows = 0;
+    for(size_t i=0;i<x_block->size1;i++){
+        // A record is the feature row followed by its target
+        size_t read = fread(gsl_matrix_ptr(x_block, i, 0), sizeof(double), features, file);
+        if(read == 0 && feof(file)) break;
+        if(read != features || fread(gsl_vector_ptr(y_block, i), sizeof(double), 1, file) != 1) return -1; // truncated record or read error
+        rows++;
+    }
+    if(ferror(file)) return -1;
+    return rows;
+}
+
+unsigned int mlr_train_blocked(mlr_row_block_reader reader, void *reader_context, size_t number_of_features, size_t block_rows, gsl_vector *coeff_set, double regularisation_param){
+    if(block_rows == 0) block_rows = 1;
+
+    //Allocating required local scoped vectors and matrices, their size never depends on the number of rows
+    gsl_matrix *x_trans_x = gsl_matrix_calloc(number_of_features, number_of_features);
+    gsl_vector *x_trans_y = gsl_vector_calloc(number_of_features);  // X^T * Y
+    gsl_matrix *x_block = gsl_matrix_alloc(block_rows, number_of_features);
+    gsl_vector *y_block = gsl_vector_alloc(block_rows);
+
+    unsigned int status = 0;
+    if(!x_trans_x||!x_trans_y||!x_block||!y_block) {
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    long rows;
+    while((rows = reader(x_block, y_block, reader_context)) > 0){
+        gsl_matrix_view x_rows = gsl_matrix_submatrix(x_block, 0, 0, (size_t)rows, number_of_features);
+        gsl_vector_view y_rows = gsl_vector_subvector(y_block, 0, (size_t)rows);
+        // x_trans_x += (x_rows^t)(x_rows), only the lower triangle is formed
+        gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &x_rows.matrix, 1.0, x_trans_x);
+        // x_trans_y += (x_rows^t)(y_rows)
+        gsl_blas_dgemv(CblasTrans, 1.0, &x_rows.matrix, &y_rows.vector, 1.0, x_trans_y);
+    }
+    if(rows < 0){
+        status = 1;
+        goto cleanup;
+    }
+
+    // Mirror the lower triangle and add the ridge term on the diagonal
+    for (size_t i = 0; i < number_of_features; i++) {
+        for (size_t j = 0; j < i; j++) {
+            gsl_matrix_set(x_trans_x, j, i, gsl_matrix_get(x_trans_x, i, j));
+        }
+        gsl_matrix_set(x_trans_x, i, i, gsl_matrix_get(x_trans_x, i, i) + regularisation_param);
+    }
+
+    if(gsl_linalg_cholesky_decomp(x_trans_x)!=GSL_SUCCESS){
+        status = 2; // 2 is for arithmatic error
+        goto cleanup;
+    }
+
+    // Solve (x_trans_x) * coeff_set = x_trans_y with the two triangular factors, no explicit inverse
+    if(gsl_linalg_cholesky_solve(x_trans_x, x_trans_y, coeff_set)!=GSL_SUCCESS) status = 2;
+
+cleanup:
+    // Free allocated memory
+    if(x_trans_x)gsl_matrix_free(x_trans_x);
+    if(x_trans_y)gsl_vector_free(x_trans_y);
+    if(x_block)gsl_matrix_free(x_block);
+    if(y_block)gsl_vector_free(y_block);
+    return status;
+}
+
+void mlr_sgd_options_default(MLRSGDOptions *options){
+    options->batch_size = 32;
+    options->epochs = 100;
+    options->learning_rate = 0.01;
+    options->momentum = 0.0;
+    options->nesterov = 0;
+    options->use_adam = 0;
+    options->adam_beta1 = 0.9;
+    options->adam_beta2 = 0.999;
+    options->adam_epsilon = 1e-8;
+    options->gradient_tolerance = 1e-6;
+    options->loss_tolerance = 0.0;
+    options->seed = 0;
+}
+
+unsigned int refine_mlr_sgd(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, MLRSGDOptions *options, unsigned int *epochs_run){
+    size_t n = x_data->size2; // number of features
+    size_t m = x_data->size1; // number of data
+    size_t batch_size = options->batch_size;
+    if(batch_size == 0 || batch_size > m) batch_size = m;
+    if(epochs_run) *epochs_run = 0;
+    if(m == 0) return 0;
+
+    //Allocating required local scoped vectors and matrices, all sized by the batch and not by the data
+    size_t *order = malloc(m*sizeof(size_t));
+    gsl_matrix *x_batch = gsl_matrix_alloc(batch_size, n);
+    gsl_vector *y_batch = gsl_vector_alloc(batch_size);
+    gsl_vector *error_set = gsl_vector_alloc(batch_size);
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *velocity = gsl_vector_calloc(n);        // momentum velocity or Adam first moment
+    gsl_vector *second_moment = gsl_vector_calloc(n);   // Adam second moment
+    gsl_vector *lookahead = gsl_vector_alloc(n);        // Nesterov evaluation point
+    gsl_vector *epoch_gradient = gsl_vector_alloc(n);
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+
+    unsigned int status = 0;
+    if(!order||!x_batch||!y_batch||!error_set||!gradient||!velocity||!second_moment||!lookahead||!epoch_gradient||!rng){
+        status = 1; // 1 is for system error
+        goto cleanup;
+    }
+
+    gsl_rng_set(rng, options->seed);
+    for(size_t i=0;i<m;i++) order[i] = i;
+
+    double previous_loss = 0, beta1_power = 1, beta2_power = 1;
+    for(unsigned int epoch=0;epoch<options->epochs;epoch++){
+        // New visiting order every epoch, reproducible through the seed
+        gsl_ran_shuffle(rng, order, m, sizeof(size_t));
+        gsl_vector_set_zero(epoch_gradient);
+        double epoch_loss = 0;
+
+        for(size_t start=0;start<m;start+=batch_size){
+            size_t rows = (m-start < batch_size) ? m-start : batch_size;
+            gsl_matrix_view x_rows = gsl_matrix_submatrix(x_batch, 0, 0, rows, n);
+            gsl_vector_view y_rows = gsl_vector_subvector(y_batch, 0, rows);
+            gsl_vector_view error_rows = gsl_vector_subvector(error_set, 0, rows);
+
+            // Gather the batch into contiguous rows so the products below run as plain dgemv
+            for(size_t r=0;r<rows;r++){
+                size_t row = order[start+r];
+                memcpy(gsl_matrix_ptr(x_batch, r, 0), gsl_matrix_const_ptr(x_data, row, 0), n*sizeof(double));
+                gsl_vector_set(y_batch, r, gsl_vector_get(y_data, row));
+            }
+
+            // Nesterov evaluates the gradient where the momentum is about to take the coefficients
+            gsl_vector *evaluation_point = coeff_set;
+            if(options->nesterov && options->momentum > 0 && !options->use_adam){
+                gsl_vector_memcpy(lookahead, coeff_set);
+                gsl_blas_daxpy(options->momentum, velocity, lookahead);
+                evaluation_point = lookahead;
+            }
+
+            // error_set = x_batch*coeff_set - y_batch
+            gsl_vector_memcpy(&error_rows.vector, &y_rows.vector);
+            gsl_blas_dgemv(CblasNoTrans, 1.0, &x_rows.matrix, evaluation_point, -1.0, &error_rows.vector);
+
+            //gradient = 1/(batch size) * x_batchTranspose*error_set, same scaling as refine_mlr_gradient_descent
+            gsl_blas_dgemv(CblasTrans, 1.0/rows, &x_rows.matrix, &error_rows.vector, 0.0, gradient);
+
+            double squared_error;
+            gsl_blas_ddot(&error_rows.vector, &error_rows.vector, &squared_error);
+            epoch_loss += squared_error;
+            gsl_blas_daxpy((double)rows, gradient, epoch_gradient);
+
+            if(options->use_adam){
+                beta1_power *= options->adam_beta1;
+                beta2_power *= options->adam_beta2;
+                for(size_t j=0;j<n;j++){
+                    double g = gsl_vector_get(gradient, j),
+                           first = options->adam_beta1*gsl_vector_get(velocity, j) + (1-options->adam_beta1)*g,
+                           second = options->adam_beta2*gsl_vector_get(second_moment, j) + (1-options->adam_beta2)*g*g;
+                    gsl_vector_set(velocity, j, first);
+                    gsl_vector_set(second_moment, j, second);
+                    // bias corrected moments
+                    double step = (first/(1-beta1_power))/(sqrt(second/(1-beta2_power)) + options->adam_epsilon);
+                    gsl_vector_set(coeff_set, j, gsl_vector_get(coeff_set, j) - options->learning_rate*step);
+                }
+            }
+            else if(options->momentum > 0){
+                // velocity = momentum*velocity - learning_rate*gradient, coeff_set += velocity
+                gsl_vector_scale(velocity, options->momentum);
+                gsl_blas_daxpy(-options->learning_rate, gradient, velocity);
+                gsl_vector_add(coeff_set, velocity);
+            }
+            else{
+                gsl_blas_daxpy(-options->learning_rate, gradient, coeff_set);
+            }
+        }
+
+        if(epochs_run) *epochs_run = epoch+1;
+
+        // Both criteria use numbers gathered during the epoch, no extra pass over the data
+        epoch_loss /= m;
+        double gradient_norm = gsl_blas_dnrm2(epoch_gradient)/m;
+        if(options->gradient_tolerance > 0 && gradient_norm < options->gradient_tolerance) break;
+        if(options->loss_tolerance > 0 && epoch > 0 && fabs(previous_loss-epoch_loss) < options->loss_tolerance) break;
+        previous_loss = epoch_loss;
+    }
+
+cleanup:
     // Free allocated memory
+    free(order);
+    if(x_batch)gsl_matrix_free(x_batch);
+    if(y_batch)gsl_vector_free(y_batch);
+    if(error_set)gsl_vector_free(error_set);
+    if(gradient)gsl_vector_free(gradient);
+    if(velocity)gsl_vector_free(velocity);
+    if(second_moment)gsl_vector_free(second_moment);
+    if(lookahead)gsl_vector_free(lookahead);
+    if(epoch_gradient)gsl_vector_free(epoch_gradient);
+    if(rng)gsl_rng_free(rng);
+    return status;
+}
+
+unsigned int mlr_train_csr(CSRMatrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param){
+    size_t n = x_data->columns;
+    if(y_data->size != x_data->rows || coeff_set->size != n) return 2; // 2 is for arithmatic error
+
+    gsl_matrix *x_trans_x = gsl_matrix_alloc(n, n);
+    gsl_vector *x_trans_y = gsl_vector_alloc(n);  // X^T * Y
+    if(!x_trans_x||!x_trans_y) {
+        if(x_trans_x)gsl_matrix_free(x_trans_x);
+        if(x_trans_y)gsl_vector_free(x_trans_y);
+        return 1; // 1 is for system error
+    }
+
+    // Both products only visit the stored entries
+    csr_gram(x_data, x_trans_x);
+    csr_dgemv(CblasTrans, 1.0, x_data, y_data, 0.0, x_trans_y);
+    unsigned int status = mlr_solve_normal_equation(x_trans_x, x_trans_y, coeff_set, regularisation_param, NULL);
+
+    gsl_vector_free(x_trans_y);
+    gsl_matrix_free(x_trans_x);
+    return status;
+}
+
+unsigned int refine_mlr_gradient_descent_csr(CSRMatrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate){
+    size_t n = x_data->columns; // number of features
+    size_t m = x_data->rows; // number of data
+    if(m == 0 || y_data->size != m || coeff_set->size != n) return 2; // 2 is for arithmatic error
+
+    gsl_vector *gradient = gsl_vector_alloc(n);
+    gsl_vector *error_set = gsl_vector_alloc(m);
+    if(!gradient||!error_set) {
+        if(gradient)gsl_vector_free(gradient);
+        if(error_set)gsl_vector_free(error_set);
+        return 1; // 1 is for system error
+    }
+
+    for(unsigned int i=0;i<iterations;i++){
+        // error_set = x_data*coeff_set - y_data
+        gsl_vector_memcpy(error_set, y_data);
+        csr_dgemv(CblasNoTrans, 1.0, x_data, coeff_set, -1.0, error_set);
+        // gradient = 1/(number of data) * x_dataTranspose*error_set
+        csr_dgemv(CblasTrans, 1.0/m, x_data, error_set, 0.0, gradient);
+        // coeff_set = coeff_set - learning_rate*gradient
+        gsl_blas_daxpy(-learning_rate, gradient, coeff_set);
+    }
+
     gsl_vector_free(gradient);
-    gsl_vector_free(prediction_set);
     gsl_vector_free(error_set);
+    return 0; //No errors
+}
 
+void mlr_predict_csr(CSRMatrix *x_new, gsl_vector *y_new, gsl_vector *coeff_set){
+    csr_dgemv(CblasNoTrans, 1.0, x_new, coeff_set, 0.0, y_new);
+}
+
+/*
+Float storage, double arithmetic: one fused pass per iteration reads every float row once and
+  r_i = x_i^T β - y_i   (double dot product)
+  gradient += r_i * x_i (double)
+instead of the two dgemv passes of the double version, so the data traffic per iteration is a
+quarter of it. β is kept in a contiguous double copy for the inner loops.
+ */
+unsigned int refine_mlr_gradient_descent_float(gsl_matrix_float *x_data, gsl_vector_float *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate){
+    size_t n = x_data->size2; // number of features
+    size_t m = x_data->size1; // number of data
+    if(m == 0 || y_data->size != m || coeff_set->size != n) return 2; // 2 is for arithmatic error
+
+    double *coeff = malloc(n*sizeof(double));
+    double *gradient = malloc(n*sizeof(double));
+    if(!coeff||!gradient){
+        free(coeff);
+        free(gradient);
+        return 1; // 1 is for system error
+    }
+    for(size_t j=0;j<n;j++) coeff[j] = gsl_vector_get(coeff_set, j);
+
+    for(unsigned int it=0;it<iterations;it++){
+        memset(gradient, 0, n*sizeof(double));
+        for(size_t i=0;i<m;i++){
+            const float *row = x_data->data + i*x_data->tda;
+            double residual = -(double)y_data->data[i*y_data->stride];
+            for(size_t j=0;j<n;j++) residual += (double)row[j]*coeff[j];
+            for(size_t j=0;j<n;j++) gradient[j] += residual*(double)row[j];
+        }
+        // coeff = coeff - learning_rate/m * gradient, the same scaling as the double version
+        double step = learning_rate/m;
+        for(size_t j=0;j<n;j++) coeff[j] -= step*gradient[j];
+    }
+
+    for(size_t j=0;j<n;j++) gsl_vector_set(coeff_set, j, coeff[j]);
+    free(coeff);
+    free(gradient);
     return 0; //No errors
+}
 
+unsigned int mlr_predict_float(gsl_matrix_float *x_new, gsl_vector_float *y_new, gsl_vector *coeff_set){
+    size_t n = x_new->size2;
+    if(y_new->size != x_new->size1 || coeff_set->size != n) return 2; // 2 is for arithmatic error
+    // β is read in place, without a bounds checked call per element in the inner loop
+    const double *coeff = coeff_set->data;
+    size_t coeff_stride = coeff_set->stride;
+    for(size_t i=0;i<x_new->size1;i++){
+        const float *row = x_new->data + i*x_new->tda;
+        double sum = 0;
+        for(size_t j=0;j<n;j++) sum += (double)row[j]*coeff[j*coeff_stride];
+        y_new->data[i*y_new->stride] = (float)sum;
+    }
+    return 0;
 }
 
-void mlr_predict(gsl_matrix *x_new,gsl_vector *y_new,gsl_vector *coeff_set){
-    gsl_blas_dgemv(CblasNoTrans,1.0,x_new,coeff_set,1.0,y_new);
+MLRIncrementalModel *mlr_incremental_alloc(size_t number_of_features, double regularisation_param){
+    if(number_of_features==0||!(regularisation_param>=0))return NULL;
+    MLRIncrementalModel *model = calloc(1, sizeof(MLRIncrementalModel));
+    if(!model)return NULL;
+    model->number_of_features = number_of_features;
+    model->regularisation_param = regularisation_param;
+    model->cholesky = gsl_matrix_calloc(number_of_features, number_of_features);
+    model->x_trans_x = gsl_matrix_calloc(number_of_features, number_of_features);
+    model->x_trans_y = gsl_vector_calloc(number_of_features);
+    model->row = gsl_vector_alloc(number_of_features);
+    if(!model->cholesky||!model->x_trans_x||!model->x_trans_y||!model->row){
+        mlr_incremental_free(model);
+        return NULL;
+    }
+    // No rows yet: X^T X + λI = λI, whose factor is sqrt(λ)I
+    for(size_t i=0;i<number_of_features;i++){
+        gsl_matrix_set(model->x_trans_x, i, i, regularisation_param);
+        gsl_matrix_set(model->cholesky, i, i, sqrt(regularisation_param));
+    }
+    model->factor_valid = regularisation_param > 0;
+    return model;
+}
+
+void mlr_incremental_free(MLRIncrementalModel *model){
+    if(!model)return;
+    if(model->cholesky)gsl_matrix_free(model->cholesky);
+    if(model->x_trans_x)gsl_matrix_free(model->x_trans_x);
+    if(model->x_trans_y)gsl_vector_free(model->x_trans_y);
+    if(model->row)gsl_vector_free(model->row);
+    free(model);
+}
+
+/*
+R^T R += x x^T for the upper factor R, one Givens rotation per diagonal entry; x is destroyed.
+R is walked by rows so every rotation reads contiguous memory
+ */
+static void mlr_cholesky_update(gsl_matrix *cholesky, gsl_vector *row){
+    size_t n = cholesky->size1, tda = cholesky->tda;
+    double *r = cholesky->data, *x = row->data;
+    size_t stride = row->stride;
+    for(size_t k=0;k<n;k++){
+        double x_k = x[k*stride];
+        if(x_k == 0.0) continue; // the rotation would be the identity
+        double r_kk = r[k*tda + k];
+        double diagonal = hypot(r_kk, x_k);
+        double c = diagonal/r_kk, s = x_k/r_kk;
+        r[k*tda + k] = diagonal;
+        for(size_t i=k+1;i<n;i++){
+            double r_ki = (r[k*tda + i] + s*x[i*stride])/c;
+            x[i*stride] = c*x[i*stride] - s*r_ki;
+            r[k*tda + i] = r_ki;
+        }
+    }
+}
+
+/*
+R^T R -= x x^T with hyperbolic rotations; x is destroyed.
+Returns -1 without finishing (R is then garbage) when a diagonal entry would lose too much
+ */
+static int mlr_cholesky_downdate(gsl_matrix *cholesky, gsl_vector *row){
+    size_t n = cholesky->size1, tda = cholesky->tda;
+    double *r = cholesky->data, *x = row->data;
+    size_t stride = row->stride;
+    for(size_t k=0;k<n;k++){
+        double x_k = x[k*stride];
+        if(x_k == 0.0) continue;
+        double r_kk = r[k*tda + k];
+        double squared = (r_kk - x_k)*(r_kk + x_k);
+        if(!(squared > MLR_DOWNDATE_TOLERANCE*r_kk*r_kk)) return -1;
+        double diagonal = sqrt(squared);
+        double c = diagonal/r_kk, s = x_k/r_kk;
+        r[k*tda + k] = diagonal;
+        for(size_t i=k+1;i<n;i++){
+            double r_ki = (r[k*tda + i] - s*x[i*stride])/c;
+            x[i*stride] = c*x[i*stride] - s*r_ki;
+            r[k*tda + i] = r_ki;
+        }
+    }
+    return 0;
+}
+
+// The rows must have the model's features and one target each
+static int mlr_incremental_fits(MLRIncrementalModel *model, gsl_matrix *x_rows, gsl_vector *y_rows){
+    return model && x_rows->size2 == model->number_of_features && y_rows->size == x_rows->size1;
+}
+
+unsigned int mlr_incremental_refactor(MLRIncrementalModel *model){
+    size_t n = model->number_of_features;
+    // Full symmetric copy of the lower triangle of X^T X + λI
+    for(size_t i=0;i<n;i++){
+        for(size_t j=0;j<=i;j++){
+            double value = gsl_matrix_get(model->x_trans_x, i, j);
+            gsl_matrix_set(model->cholesky, i, j, value);
+            gsl_matrix_set(model->cholesky, j, i, value);
+        }
+    }
+    if(gsl_linalg_cholesky_decomp(model->cholesky)!=GSL_SUCCESS){
+        model->factor_valid = 0;
+        return 2; // 2 is for arithmatic error
+    }
+    // GSL leaves L in the lower triangle, R = L^T goes to the upper one
+    for(size_t i=0;i<n;i++){
+        for(size_t j=0;j<i;j++) gsl_matrix_set(model->cholesky, j, i, gsl_matrix_get(model->cholesky, i, j));
+    }
+    model->factor_valid = 1;
+    return 0; //No errors
+}
+
+unsigned int mlr_incremental_add(MLRIncrementalModel *model, gsl_matrix *x_rows, gsl_vector *y_rows){
+    if(!mlr_incremental_fits(model, x_rows, y_rows))return 2; // 2 is for arithmatic error
+    // x_trans_x += (x_rows^t)(x_rows) on the lower triangle, x_trans_y += (x_rows^t)(y_rows)
+    gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, x_rows, 1.0, model->x_trans_x);
+    gsl_blas_dgemv(CblasTrans, 1.0, x_rows, y_rows, 1.0, model->x_trans_y);
+    model->number_of_data += x_rows->size1;
+
+    if(!model->factor_valid){
+        // Not positive definite before these rows, so there is no factor to update
+        mlr_incremental_refactor(model);
+        return 0; //No errors
+    }
+    for(size_t i=0;i<x_rows->size1;i++){
+        gsl_vector_view row = gsl_matrix_row(x_rows, i);
+        gsl_vector_memcpy(model->row, &row.vector);
+        mlr_cholesky_update(model->cholesky, model->row);
+    }
+    return 0; //No errors
+}
+
+unsigned int mlr_incremental_remove(MLRIncrementalModel *model, gsl_matrix *x_rows, gsl_vector *y_rows){
+    if(!mlr_incremental_fits(model, x_rows, y_rows)||x_rows->size1 > model->number_of_data)return 2; // 2 is for arithmatic error
+    size_t n = model->number_of_features;
+    model->number_of_data -= x_rows->size1;
+    if(model->number_of_data == 0){
+        // Empty again: reset the sums exactly instead of keeping the rounding of the subtraction
+        gsl_matrix_set_zero(model->x_trans_x);
+        gsl_vector_set_zero(model->x_trans_y);
+        gsl_matrix_set_zero(model->cholesky);
+        for(size_t i=0;i<n;i++){
+            gsl_matrix_set(model->x_trans_x, i, i, model->regularisation_param);
+            gsl_matrix_set(model->cholesky, i, i, sqrt(model->regularisation_param));
+        }
+        model->factor_valid = model->regularisation_param > 0;
+        return 0; //No errors
+    }
+    gsl_blas_dsyrk(CblasLower, CblasTrans, -1.0, x_rows, 1.0, model->x_trans_x);
+    gsl_blas_dgemv(CblasTrans, -1.0, x_rows, y_rows, 1.0, model->x_trans_y);
+
+    // Fewer rows cannot make a singular X^T X positive definite
+    if(!model->factor_valid)return 0; //No errors
+    for(size_t i=0;i<x_rows->size1;i++){
+        gsl_vector_view row = gsl_matrix_row(x_rows, i);
+        gsl_vector_memcpy(model->row, &row.vector);
+        if(mlr_cholesky_downdate(model->cholesky, model->row) != 0){
+            // R is half rotated; x_trans_x already excludes the whole batch, so one refactorisation replaces the remaining downdates
+            model->refactorisations++;
+            mlr_incremental_refactor(model);
+            break;
+        }
+    }
+    return 0; //No errors
+}
+
+unsigned int mlr_incremental_solve(MLRIncrementalModel *model, gsl_vector *coeff_set){
+    if(coeff_set->size != model->number_of_features||!model->factor_valid)return 2; // 2 is for arithmatic error
+    // R^T z = X^T Y, then R β = z
+    gsl_vector_memcpy(coeff_set, model->x_trans_y);
+    gsl_blas_dtrsv(CblasUpper, CblasTrans, CblasNonUnit, model->cholesky, coeff_set);
+    gsl_blas_dtrsv(CblasUpper, CblasNoTrans, CblasNonUnit, model->cholesky, coeff_set);
+    return 0; //No errors
 }
@@ -23,6 +23,76 @@
 
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
+#include "../SparseMatrix/sparse_matrix.h"
+#include "../Telemetry/training_telemetry.h"
+#include "../FeatureScaling/feature_scaling.h"
+
+/*
+ * Type: mlr_row_block_reader
+ * ----------------------------
+ * A callback that supplies the training data of `mlr_train_blocked` one block of rows at a time.
+ * It must write up to `x_block->size1` rows into the first rows of `x_block` and the matching 
+ * targets into `y_block`, and return how many rows it wrote. It returns 0 once the data is 
+ * exhausted, or a negative value if reading failed. `reader_context` is passed through untouched.
+ */
+typedef long (*mlr_row_block_reader)(gsl_matrix *x_block, gsl_vector *y_block, void *reader_context);
+
+/*
+ * Type: MLRSGDOptions
+ * ----------------------------
+ * Settings of `refine_mlr_sgd`, fill with `mlr_sgd_options_default` and change what is needed.
+ */
+typedef struct {
+size_t batch_size;          // rows per update step (0 or more than the rows means full batch)
+unsigned int epochs;        // maximum number of passes over the data
+double learning_rate;
+double momentum;            // 0 disables momentum, typical 0.9
+int nesterov;               // 1 for Nesterov momentum (evaluate the gradient at the look-ahead point)
+int use_adam;               // 1 for Adam updates, momentum and nesterov are then ignored
+double adam_beta1;
+double adam_beta2;
+double adam_epsilon;
+double gradient_tolerance;  // stop when the epoch's mean gradient norm falls below it (0 disables)
+double loss_tolerance;      // stop when the epoch's MSE changes by less than it (0 disables)
+unsigned long seed;         // seed of the shuffling, equal seeds give equal results
+}MLRSGDOptions;
+
+/*
+ * Type: MLRWorkspace
+ * ----------------------------
+ * Scratch memory of `mlr_train_ws` and `refine_mlr_gradient_descent_ws`, created once with 
+ * `mlr_workspace_alloc` for a maximum number of rows and an exact number of features, and 
+ * reused for as many calls as needed. Its members are internal to the library.
+ */
+typedef struct {
+size_t number_of_data;      // maximum rows
+size_t number_of_features;  // exact features
+gsl_matrix *x_trans_x;      // features x features
+gsl_vector *x_trans_y;      // features
+gsl_vector *gradient;       // features
+gsl_vector *prediction_set; // rows
+gsl_vector *error_set;      // rows
+}MLRWorkspace;
+
+/*
+ * Type: MLRIncrementalModel
+ * ----------------------------
+ * A ridge regression over a set of rows that changes over time, e.g. a sliding window over a 
+ * stream, created with `mlr_incremental_alloc`. Batches of rows are added and removed and the 
+ * coefficients can be solved at any time without visiting the rows still in the model. Only 
+ * `number_of_data` and `refactorisations` are meant to be read, the rest is internal.
+ */
+typedef struct {
+size_t number_of_features;      // exact features
+double regularisation_param;    // λ
+size_t number_of_data;          // rows currently in the model
+gsl_matrix *cholesky;           // features x features, upper triangle holds R with R^T R = X^T X + λI
+gsl_matrix *x_trans_x;          // features x features, lower triangle holds X^T X + λI
+gsl_vector *x_trans_y;          // features
+gsl_vector *row;                // features, scratch for one row
+int factor_valid;               // 0 while X^T X + λI is not positive definite (λ = 0, too few rows)
+unsigned long refactorisations; // times R was rebuilt because a removal was ill-conditioned
+}MLRIncrementalModel;
 
 
 /*
@@ -63,6 +133,47 @@ unsigned int mlr_train(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff
  *    - `2` if an arithmetic error occurred (e.g., failure during Cholesky decomposition).
 */
 
+/*
+ * Function: mlr_ridge_path
+ * ----------------------------
+ */
+unsigned int mlr_ridge_path(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *lambdas, gsl_matrix *coeff_path, gsl_vector *gcv_scores);
+/*
+ * Computes the ridge coefficients β(λ) = (X^T X + λI)^(-1) X^T y of `mlr_train` for a whole 
+ * vector of λ values at once, to choose the regularisation parameter.
+ *
+ * Calling `mlr_train` per λ repeats the O(m n^2) product X^T X and an O(n^3) factorisation every 
+ * time. This function forms X^T X and X^T y once and eigendecomposes X^T X = V D V^T once. Since 
+ * X^T X + λI = V (D + λI) V^T has the same eigenvectors, every λ then only costs
+ *    β(λ) = V * diag(1/(d_i + λ)) * (V^T X^T y)        O(n^2)
+ * so a sweep over 100 values costs about as much as a single `mlr_train`.
+ *
+ * With `gcv_scores` it also scores every λ with **generalised cross-validation**, an estimate of 
+ * the leave-one-out prediction error that needs no refitting:
+ *    GCV(λ) = (1/m) * ||y - Xβ(λ)||^2 / (1 - df(λ)/m)^2,   df(λ) = Σ d_i/(d_i + λ)
+ * where df(λ) is the effective number of parameters. The residual is computed in the eigenbasis 
+ * from X^T y and y^T y, in O(n) without touching X again. The λ with the lowest score is the 
+ * suggested one (`gsl_vector_min_index(gcv_scores)`).
+ *
+ * Arguments:
+ *    - x_data: A `gsl_matrix` (m x n) of features, as for `mlr_train`.
+ *    - y_data: A `gsl_vector` of the m targets.
+ *    - lambdas: A `gsl_vector` of the L regularisation parameters (λ >= 0), in any order.
+ *    - coeff_path: A `gsl_matrix` (L x n), row k receives β(lambdas[k]).
+ *    - gcv_scores: A `gsl_vector` of L receiving the GCV scores, or NULL to skip them.
+ *
+ * Returns:
+ *    - `0` if all coefficients were computed.
+ *    - `1` if there was a system error (e.g., memory allocation failure).
+ *    - `2` if a dimension does not match, a λ is negative, X^T X + λI is singular for one of the 
+ *      λ (λ = 0 with linearly dependent columns) or the eigendecomposition fails.
+ *
+ * Notes:
+ *    - The residual is y^T y minus terms of similar size, so when the fit is almost exact its 
+ *      relative accuracy drops; it is clamped at 0. The scores stay fine for ranking λ values.
+ *    - GCV is +infinity where df(λ) reaches m (more effective parameters than rows).
+ */
+
 /*
  * Function: refine_mlr_gradient_descent
  * ----------------------------
@@ -110,6 +221,74 @@ unsigned int refine_mlr_gradient_descent(gsl_matrix *x_data, gsl_vector *y_data,
  */
 
 
+/*
+ * Function: mlr_workspace_alloc
+ * ----------------------------
+ */
+MLRWorkspace *mlr_workspace_alloc(size_t number_of_data, size_t number_of_features);
+/*
+ * Allocates a workspace for the `_ws` functions, for data with at most `number_of_data` rows and 
+ * exactly `number_of_features` columns. All memory of the `_ws` functions is taken from here, so 
+ * a training or serving loop that reuses one workspace does no heap allocation after this call.
+ * It holds a (number_of_features x number_of_features) matrix and 2 * number_of_data + 
+ * 2 * number_of_features doubles.
+ *
+ * Arguments:
+ *    - number_of_data: The largest number of rows the workspace will be used with.
+ *    - number_of_features: The number of columns of the data.
+ *
+ * Returns:
+ *    - A pointer to the workspace, to be released with `mlr_workspace_free`.
+ *    - `NULL` if an allocation failed or a size is 0.
+ */
+
+
+/*
+ * Function: mlr_workspace_free
+ * ----------------------------
+ */
+void mlr_workspace_free(MLRWorkspace *workspace);
+/*
+ * Frees a workspace created by `mlr_workspace_alloc`. Passing `NULL` does nothing.
+ */
+
+
+/*
+ * Function: mlr_train_ws
+ * ----------------------------
+ */
+unsigned int mlr_train_ws(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, MLRWorkspace *workspace);
+/*
+ * Same as `mlr_train`, but with its scratch memory taken from `workspace`, so it never allocates.
+ *
+ * Arguments:
+ *    - x_data, y_data, coeff_set, regularisation_param: As for `mlr_train`.
+ *    - workspace: A workspace with the same number of features as `x_data` and at least as many rows.
+ *
+ * Returns:
+ *    - `0` if the training was successful.
+ *    - `2` if the workspace does not fit the data or the Cholesky decomposition failed.
+ */
+
+
+/*
+ * Function: refine_mlr_gradient_descent_ws
+ * ----------------------------
+ */
+unsigned int refine_mlr_gradient_descent_ws(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate, MLRWorkspace *workspace);
+/*
+ * Same as `refine_mlr_gradient_descent`, but with its scratch memory taken from `workspace`, so 
+ * it never allocates. The data may have fewer rows than the workspace was created for.
+ *
+ * Arguments:
+ *    - x_data, y_data, coeff_set, iterations, learning_rate: As for `refine_mlr_gradient_descent`.
+ *    - workspace: A workspace with the same number of features as `x_data` and at least as many rows.
+ *
+ * Returns:
+ *    - `0` if the coefficients were updated.
+ *    - `2` if the workspace does not fit the data.
+ */
+
 /*
  * Function: mlr_predict
  * ----------------------------
@@ -136,4 +315,415 @@ void mlr_predict(gsl_matrix *x_new, gsl_vector *y_new, gsl_vector *coeff_set);
  *      predicted values.
  */
 
+/*
+ * Function: mlr_predict_batch
+ * ----------------------------
+ */
+void mlr_predict_batch(gsl_matrix *x_new, gsl_vector *y_new, gsl_vector *coeff_set);
+ /* This function computes the same predictions as `mlr_predict`:
+ *   y_new = x_new * coeff_set
+ * but is tuned for scoring many rows of a model with few features.
+ *
+ * For up to 16 features the rows are scored by a dedicated kernel that keeps the coefficients 
+ * in registers and works on 4 rows at a time (with AVX2 when the CPU supports it, checked at 
+ * runtime, otherwise with plain C). For such narrow rows this avoids the per-row overhead of 
+ * the generic BLAS routine. Wider models are passed on to `gsl_blas_dgemv`.
+ *
+ * Arguments:
+ *    - x_new: A `gsl_matrix` of size (m_new x n) holding the rows to score. Submatrix views are accepted.
+ *    - y_new: A `gsl_vector` of size m_new that will store the predicted values.
+ *    - coeff_set: A `gsl_vector` of size n containing the coefficients (including intercept) from the 
+ *      trained model.
+ *
+ * Returns:
+ *    - This function does not return a value. It directly updates the `y_new` vector with the 
+ *      predicted values.
+ *
+ * Notes:
+ *    - Unlike `mlr_predict`, the previous content of `y_new` is overwritten and not added to, 
+ *      so `y_new` does not need to be zeroed first.
+ *    - The summation order differs from `gsl_blas_dgemv`, results may differ in the last bits.
+ */
+
+/*
+ * Function: mlr_train_blocked
+ * ----------------------------
+ */
+unsigned int mlr_train_blocked(mlr_row_block_reader reader, void *reader_context, size_t number_of_features, size_t block_rows, gsl_vector *coeff_set, double regularisation_param);
+/* This function fits the same ridge regularised model as `mlr_train`:
+ *   β = (X^T * X + λ * I)^(-1) * X^T * y
+ * but never needs the whole of X in memory, so it can train on tables larger than RAM.
+ *
+ * The rows are pulled from `reader` in blocks of `block_rows`. For every block X_b (with targets y_b) 
+ * the normal equation terms are accumulated:
+ *   X^T * X += X_b^T * X_b      (symmetric rank-k update, gsl_blas_dsyrk)
+ *   X^T * y += X_b^T * y_b
+ * Since X^T * X = Σ X_b^T * X_b over all blocks, the result is the same as with the full matrix.
+ * Afterwards λ is added to the diagonal, the matrix is Cholesky decomposed (L * L^T) and the 
+ * system is solved by forward and back substitution instead of forming the inverse, which is 
+ * cheaper and numerically more accurate.
+ *
+ * Peak memory is one (n x n) matrix plus one block: O(n^2 + block_rows * n), whatever the number of rows.
+ *
+ * Arguments:
+ *    - reader: The `mlr_row_block_reader` callback supplying the rows. `mlr_file_block_reader` reads 
+ *      them from a binary file.
+ *    - reader_context: Passed to every `reader` call (e.g. the `FILE *` for `mlr_file_block_reader`).
+ *    - number_of_features: The number of features n (columns of X, including the intercept column).
+ *    - block_rows: The number of rows requested per `reader` call. A few thousand rows is usually 
+ *      enough to keep the rank-k update efficient.
+ *    - coeff_set: A `gsl_vector` of size n that will store the resulting coefficients.
+ *    - regularisation_param: The ridge regularization parameter (λ).
+ *
+ * Returns:
+ *    - `0` if the training was successful.
+ *    - `1` if there was a system error (memory allocation failure or the reader reported an error).
+ *    - `2` if an arithmetic error occurred (e.g., failure during Cholesky decomposition).
+ */
+
+/*
+ * Function: mlr_file_block_reader
+ * ----------------------------
+ */
+long mlr_file_block_reader(gsl_matrix *x_block, gsl_vector *y_block, void *reader_context);
+/* A ready made `mlr_row_block_reader` that reads rows from a binary file opened with fopen(path, "rb"),
+ * passed as `reader_context`. Every record is n native doubles of features followed by one double 
+ * target, records are stored back to back:
+ *   x_11 x_12 ... x_1n y_1 x_21 x_22 ... x_2n y_2 ...
+ *
+ * Example:
+ *   FILE *file = fopen("train.bin", "rb");
+ *   unsigned int status = mlr_train_blocked(mlr_file_block_reader, file, 4, 4096, coeff_set, 0.1);
+ *   fclose(file);
+ *
+ * Returns:
+ *    - The number of rows read, 0 at the end of the file, or -1 on a read error or truncated record.
+ */
+
+/*
+ * Function: mlr_sgd_options_default
+ * ----------------------------
+ */
+void mlr_sgd_options_default(MLRSGDOptions *options);
+/* Fills `options` with: batch_size 32, 100 epochs, learning rate 0.01, no momentum, no Adam 
+ * (betas 0.9 / 0.999, epsilon 1e-8), gradient tolerance 1e-6, no loss tolerance, seed 0.
+ */
+
+/*
+ * Function: refine_mlr_sgd
+ * ----------------------------
+ */
+unsigned int refine_mlr_sgd(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, MLRSGDOptions *options, unsigned int *epochs_run);
+/* Performs **Mini-batch Stochastic Gradient Descent** on the same MSE objective as 
+ * `refine_mlr_gradient_descent`. Instead of one step per full pass over the data, it takes one step 
+ * per batch of `batch_size` rows, so a single pass (epoch) already makes m / batch_size updates.
+ *
+ * Every epoch the rows are visited in a new random order (seeded, so runs are reproducible). For 
+ * every batch B the gradient is:
+ *   gradient = (1/|B|) * X_B^T * (X_B * β - y_B)
+ * and the coefficients are updated with one of:
+ *   - plain SGD:   β = β - α * gradient
+ *   - momentum:    v = μ * v - α * gradient,  β = β + v
+ *   - Nesterov:    as momentum, but the gradient is taken at β + μ * v
+ *   - Adam:        m = β1 * m + (1 - β1) * gradient,  s = β2 * s + (1 - β2) * gradient^2
+ *                  β = β - α * (m / (1 - β1^t)) / (sqrt(s / (1 - β2^t)) + ε)
+ *
+ * Training stops after `epochs` epochs, or earlier when the mean gradient norm of an epoch falls below 
+ * `gradient_tolerance` or the MSE changes less than `loss_tolerance` between two epochs. Both values 
+ * are gathered from the batches while the epoch runs, so checking them costs no extra pass.
+ *
+ * Arguments:
+ *    - x_data: A pointer to a `gsl_matrix` (m x n) with the independent variables (X).
+ *    - y_data: A pointer to a `gsl_vector` with the m values of the dependent variable (y).
+ *    - coeff_set: A pointer to a `gsl_vector` with the n starting coefficients (e.g. from `mlr_train`, or 
+ *      zeros), updated in place.
+ *    - options: A pointer to the `MLRSGDOptions` to use.
+ *    - epochs_run: If not NULL, receives the number of epochs actually run.
+ *
+ * Returns:
+ *    - `0` if the optimization ran.
+ *    - `1` if there was a system error (e.g., memory allocation failure).
+ */
+
+/*
+ * Function: mlr_train_csr
+ * ----------------------------
+ */
+unsigned int mlr_train_csr(CSRMatrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param);
+/*
+ * Same as `mlr_train` for a sparse (CSR) feature matrix, e.g. one-hot or hashed features. X^T * X 
+ * is accumulated from the outer products of the sparse rows and X^T * y from the stored entries, 
+ * so the data costs the sum over the rows of (entries in the row)^2 instead of m * n^2. The 
+ * (n x n) normal equation itself is still dense, so this suits up to a few thousand features; 
+ * for more use `refine_mlr_gradient_descent_csr`.
+ *
+ * Returns:
+ *    - `0` if the training was successful.
+ *    - `1` if there was a system error (e.g., memory allocation failure).
+ *    - `2` if a dimension does not match or the Cholesky decomposition failed.
+ */
+
+
+/*
+ * Function: refine_mlr_gradient_descent_csr
+ * ----------------------------
+ */
+unsigned int refine_mlr_gradient_descent_csr(CSRMatrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate);
+/*
+ * Same as `refine_mlr_gradient_descent` for a sparse (CSR) feature matrix. Every iteration costs 
+ * O(nnz + m + n) instead of O(m * n).
+ *
+ * Returns:
+ *    - `0` if the coefficients were updated.
+ *    - `1` if there was a system error (e.g., memory allocation failure).
+ *    - `2` if a dimension does not match.
+ */
+
+
+/*
+ * Function: mlr_predict_csr
+ * ----------------------------
+ */
+void mlr_predict_csr(CSRMatrix *x_new, gsl_vector *y_new, gsl_vector *coeff_set);
+/*
+ * Predicts y_new = X_new * β for a sparse (CSR) matrix of new rows in O(nnz). Like 
+ * `mlr_predict_batch`, the previous content of `y_new` is overwritten.
+ */
+
+/*
+ * Function: refine_mlr_gradient_descent_float
+ * ----------------------------
+ */
+unsigned int refine_mlr_gradient_descent_float(gsl_matrix_float *x_data, gsl_vector_float *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate);
+/*
+ * Same as `refine_mlr_gradient_descent` for data stored in single precision. Gradient descent 
+ * is limited by how fast the data can be read from memory, and floats halve the bytes read. 
+ * Only the storage is single precision: every product, sum, the gradient and the coefficients 
+ * are computed in double, so the results differ from the double version only by the rounding 
+ * of the data to float (about 7 significant digits).
+ *
+ * Each iteration is a single fused pass over the rows, computing the residual of a row and 
+ * adding its contribution to the gradient while the row is still in cache.
+ *
+ * Arguments:
+ *    - x_data: A `gsl_matrix_float` (m x n) of features.
+ *    - y_data: A `gsl_vector_float` of the m targets.
+ *    - coeff_set, iterations, learning_rate: As for `refine_mlr_gradient_descent` (coefficients 
+ *      stay in double).
+ *
+ * Returns:
+ *    - `0` if the coefficients were updated.
+ *    - `1` if there was a system error (e.g., memory allocation failure).
+ *    - `2` if a dimension does not match.
+ */
+
+
+/*
+ * Function: mlr_predict_float
+ * ----------------------------
+ */
+unsigned int mlr_predict_float(gsl_matrix_float *x_new, gsl_vector_float *y_new, gsl_vector *coeff_set);
+/*
+ * Predicts y_new = X_new * β for rows stored in single precision. The sums are accumulated in 
+ * double and rounded to float once. Like `mlr_predict_batch`, `y_new` is overwritten. It needs 
+ * no scratch memory.
+ *
+ * Returns:
+ *    - `0` if prediction completes successfully.
+ *    - `2` if a dimension does not match.
+ */
+
+
+/*
+ * Function: mlr_train_instrumented
+ * ----------------------------
+ */
+unsigned int mlr_train_instrumented(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, double regularisation_param, TrainingTelemetry *telemetry);
+/*
+ * Same as `mlr_train`, and fills `telemetry` (see [Telemetry](../Telemetry)) with the wall time 
+ * of the three phases (`TELEMETRY_GRAM` for X^T X and X^T Y, `TELEMETRY_CHOLESKY`, 
+ * `TELEMETRY_SOLVE`), the bytes streamed and the allocations made. When it returns 2 the phase 
+ * times show the Cholesky factorisation was reached and failed (X^T X + λI is not positive 
+ * definite), and `TELEMETRY_SOLVE` stays 0. There are no iterations, so no samples are taken.
+ *
+ * Returns:
+ *    - As `mlr_train`.
+ */
+
+
+/*
+ * Function: refine_mlr_gradient_descent_instrumented
+ * ----------------------------
+ */
+unsigned int refine_mlr_gradient_descent_instrumented(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate, TrainingTelemetry *telemetry);
+/*
+ * Same as `refine_mlr_gradient_descent`, and fills `telemetry`: the time of all iterations 
+ * (`TELEMETRY_ITERATIONS`, of which `TELEMETRY_PRODUCTS` went to the products Xβ and X^T(Xβ - Y) 
+ * and `TELEMETRY_UPDATE` to the error and the update of β), the number performed, bytes and 
+ * allocations. Every 
+ * `sample_stride` iterations the MSE (1/m)*||Xβ - Y||^2 and the norm of the gradient 
+ * (1/m)*X^T(Xβ - Y) at the current β are recorded and passed to the callback; both come from 
+ * vectors the iteration computes anyway, so a sample costs O(m + n). If the callback returns 
+ * non zero, training stops before that iteration changes β.
+ *
+ * Returns:
+ *    - As `refine_mlr_gradient_descent`.
+ *    - `3` if the callback stopped training (β holds the last completed iteration).
+ */
+
+/*
+ * Function: refine_mlr_gradient_descent_scaled
+ * ----------------------------
+ */
+unsigned int refine_mlr_gradient_descent_scaled(gsl_matrix *x_data, gsl_vector *y_data, gsl_vector *coeff_set, unsigned int iterations, double learning_rate, FeatureScaling *scaling);
+/*
+ * Same as `refine_mlr_gradient_descent`, but the steps are taken as if every column of `x_data` 
+ * were standardised (see [FeatureScaling](../FeatureScaling)). When the columns have very 
+ * different ranges the plain iteration needs a learning rate small enough for the widest column 
+ * and then crawls along the others; standardised columns converge in far fewer iterations, 
+ * typically with a learning rate between 0.1 and 1.
+ * Nothing is copied: the column statistics take one pass over the rows, and each iteration does 
+ * the same two products with `x_data` as the plain one plus O(n) work on the coefficients and 
+ * the gradient. `coeff_set` is read and returned for the original columns, so it can be passed 
+ * to `mlr_predict` as it is. Memory is n + m doubles (plus 2n without `scaling`).
+ *
+ * Arguments:
+ *    - x_data, y_data, coeff_set, iterations, learning_rate: As for `refine_mlr_gradient_descent`.
+ *    - scaling: NULL to compute the statistics for this call only, or a FeatureScaling whose 
+ *      `mean` and `deviation` vectors (n entries) receive them. With `reuse` set the statistics 
+ *      already in it are used, e.g. those of an earlier call on the same data.
+ *
+ * Returns:
+ *    - 0 on success
+ *    - 1 if an allocation failed.
+ *    - 2 if the sizes of `x_data`, `y_data`, `coeff_set` or the scaling vectors do not match, or 
+ *      `x_data` has no rows.
+ */
+
+/*
+ * Function: mlr_incremental_alloc
+ * ----------------------------
+ */
+MLRIncrementalModel *mlr_incremental_alloc(size_t number_of_features, double regularisation_param);
+/*
+ * Creates an empty incremental model. It keeps the Cholesky factor R of X^T X + λI (R^T R) for 
+ * the rows currently added, together with X^T X + λI and X^T Y themselves, so that:
+ *    - adding or removing a batch of k rows costs O(k n^2): every row is a rank-1 update 
+ *      (Givens rotations) or downdate (hyperbolic rotations) of R, never a new O(n^3) 
+ *      factorisation or a pass over the old rows,
+ *    - solving β costs O(n^2), two triangular solves with R.
+ * A sliding window of w rows moved by k rows therefore costs O(k n^2) instead of the O(w n^2) of 
+ * calling `mlr_train` on the window. Memory is 2 * n^2 + 2 * n doubles, whatever the rows.
+ *
+ * Arguments:
+ *    - number_of_features: The number of columns n of the rows.
+ *    - regularisation_param: λ >= 0, as for `mlr_train`. With λ > 0 the model can be solved at 
+ *      any time (an empty model gives β = 0); with λ = 0 only once the rows have full rank.
+ *
+ * Returns:
+ *    - A pointer to the model, to be released with `mlr_incremental_free`.
+ *    - `NULL` if an allocation failed, `number_of_features` is 0 or λ is negative.
+ */
+
+
+/*
+ * Function: mlr_incremental_free
+ * ----------------------------
+ */
+void mlr_incremental_free(MLRIncrementalModel *model);
+/*
+ * Frees a model created by `mlr_incremental_alloc`. Passing `NULL` does nothing.
+ */
+
+
+/*
+ * Function: mlr_incremental_add
+ * ----------------------------
+ */
+unsigned int mlr_incremental_add(MLRIncrementalModel *model, gsl_matrix *x_rows, gsl_vector *y_rows);
+/*
+ * Adds k rows to the model: X^T X += X_k^T X_k, X^T Y += X_k^T Y_k and one rank-1 update of R 
+ * per row. Updates are always numerically stable. While the model is not yet positive definite 
+ * (λ = 0) the factor is computed from X^T X instead, once the rows reach full rank.
+ *
+ * Arguments:
+ *    - model: The model.
+ *    - x_rows: A `gsl_matrix` (k x n) of the new rows.
+ *    - y_rows: A `gsl_vector` of their k targets.
+ *
+ * Returns:
+ *    - `0` if the rows were added.
+ *    - `2` if a dimension does not match (the model is unchanged).
+ */
+
+
+/*
+ * Function: mlr_incremental_remove
+ * ----------------------------
+ */
+unsigned int mlr_incremental_remove(MLRIncrementalModel *model, gsl_matrix *x_rows, gsl_vector *y_rows);
+/*
+ * Removes k rows that were added before (e.g. the oldest rows of a sliding window), with one 
+ * rank-1 downdate of R per row. The caller must pass exactly the values that were added; the 
+ * model keeps no rows and cannot check this.
+ *
+ * Unlike an update, a downdate subtracts: when a row carries most of the information about some 
+ * direction, the diagonal of R shrinks towards 0 and the rotations lose precision. A downdate 
+ * that would leave less than 1e-8 of a squared diagonal entry (about half of the digits) is 
+ * abandoned, and R is refactorised in O(n^3) from the X^T X + λI kept alongside it 
+ * (`refactorisations` counts these fallbacks). If that matrix is no longer positive definite 
+ * (λ = 0 and too few rows remain), the model stays unsolvable until enough rows are added.
+ *
+ * Arguments:
+ *    - model: The model.
+ *    - x_rows: A `gsl_matrix` (k x n) of the rows to remove.
+ *    - y_rows: A `gsl_vector` of their k targets.
+ *
+ * Returns:
+ *    - `0` if the rows were removed.
+ *    - `2` if a dimension does not match or k is larger than the rows in the model (the model is 
+ *      unchanged).
+ *
+ * Notes:
+ *    - X^T X and X^T Y are running sums, so after very many additions and removals of large 
+ *      values they carry rounding from cancellation; removing all rows resets them exactly.
+ */
+
+
+/*
+ * Function: mlr_incremental_refactor
+ * ----------------------------
+ */
+unsigned int mlr_incremental_refactor(MLRIncrementalModel *model);
+/*
+ * Recomputes R from X^T X + λI in O(n^3), discarding the rounding accumulated by many updates 
+ * and downdates. `mlr_incremental_remove` does this itself when needed; a long running window 
+ * may also call it periodically (e.g. every few thousand batches).
+ *
+ * Returns:
+ *    - `0` if R was recomputed.
+ *    - `2` if X^T X + λI is not positive definite (the model cannot be solved until more rows 
+ *      are added).
+ */
+
+
+/*
+ * Function: mlr_incremental_solve
+ * ----------------------------
+ */
+unsigned int mlr_incremental_solve(MLRIncrementalModel *model, gsl_vector *coeff_set);
+/*
+ * Solves (X^T X + λI) * β = X^T Y for the rows currently in the model, with two triangular 
+ * solves against R in O(n^2). The result equals `mlr_train` on the same rows up to rounding.
+ *
+ * Arguments:
+ *    - model: The model.
+ *    - coeff_set: A `gsl_vector` of n receiving β.
+ *
+ * Returns:
+ *    - `0` if β was computed.
+ *    - `2` if the size of `coeff_set` does not match or X^T X + λI is not positive definite 
+ *      (λ = 0 with fewer independent rows than features).
+ */
+
 #endif // MLR_H
@@ -0,0 +1,138 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput of the softmax regression entry points on synthetic data.
+ * Usage: ./benchmark [-j] [-q] [-r repetitions]
+ *    -j  print the results as JSON, for tracking regressions between versions
+ *    -q  quick run on the small sizes only
+ *    -r  timed repetitions per case, the median is reported (default 5)
+ * Every row belongs to the class whose feature block has the largest sum, 4 classes, at 10^3 to 
+ * 10^6 rows and 8 or 64 features (sizes above 16M values are skipped). Exponentials are not 
+ * counted as floating point operations. See Benchmark/README.md for how the rates are defined.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "softmax_regression.h"
+#include "../Benchmark/benchmark_report.h"
+
+#define BENCHMARK_CLASSES 4
+// Epochs per softmax_regression_train call
+#define BENCHMARK_EPOCHS 2
+// Largest rows x features generated
+#define BENCHMARK_MAX_VALUES (1u<<24)
+
+typedef struct {
+gsl_matrix *x_data;
+gsl_vector *y_data;
+gsl_matrix *probability_set;
+gsl_vector *prediction_set;
+gsl_matrix *weight_set;
+SoftmaxTrainOptions options;
+}SoftmaxCase;
+
+static void run_train(void *context){
+    SoftmaxCase *c = context;
+    gsl_matrix_set_zero(c->weight_set);
+    softmax_regression_train(c->y_data, c->x_data, c->weight_set, &c->options, NULL, NULL);
+}
+
+static void run_predict(void *context){
+    SoftmaxCase *c = context;
+    softmax_regression_predict(c->probability_set, c->prediction_set, c->weight_set, c->x_data);
+}
+
+static void run_predict_labels(void *context){
+    SoftmaxCase *c = context;
+    softmax_regression_predict(NULL, c->prediction_set, c->weight_set, c->x_data);
+}
+
+int main(int argc, char **argv){
+    BenchmarkReport report;
+    if(benchmark_parse_arguments(&report, "softmax_regression", argc, argv) != 0) return 1;
+    size_t row_sizes[] = {1000, 10000, 100000, 1000000};
+    size_t feature_sizes[] = {8, 64};
+    size_t number_of_row_sizes = report.quick ? 2 : 4;
+
+    benchmark_begin(&report);
+    for(size_t r=0;r<number_of_row_sizes;r++){
+        for(size_t f=0;f<2;f++){
+            size_t rows = row_sizes[r], features = feature_sizes[f];
+            if(rows*features > BENCHMARK_MAX_VALUES) continue;
+            SoftmaxCase c;
+            c.x_data = gsl_matrix_alloc(rows, features);
+            c.y_data = gsl_vector_alloc(rows);
+            c.probability_set = gsl_matrix_alloc(rows, BENCHMARK_CLASSES);
+            c.prediction_set = gsl_vector_alloc(rows);
+            c.weight_set = gsl_matrix_calloc(features, BENCHMARK_CLASSES);
+            if(!c.x_data||!c.y_data||!c.probability_set||!c.prediction_set||!c.weight_set){
+                fprintf(stderr, "Could not allocate %zu x %zu data\n", rows, features);
+                return 1;
+            }
+            softmax_train_options_default(&c.options);
+            c.options.epochs = BENCHMARK_EPOCHS;
+            // Feature j (after the bias column) counts towards class j % 4
+            srand(42);
+            for(size_t i=0;i<rows;i++){
+                double sums[BENCHMARK_CLASSES] = {0};
+                gsl_matrix_set(c.x_data, i, 0, 1.0);
+                for(size_t j=1;j<features;j++){
+                    double value = (double)rand()/RAND_MAX;
+                    gsl_matrix_set(c.x_data, i, j, value);
+                    sums[j % BENCHMARK_CLASSES] += value;
+                }
+                size_t best = 0;
+                for(size_t k=1;k<BENCHMARK_CLASSES;k++) if(sums[k] > sums[best]) best = k;
+                gsl_vector_set(c.y_data, i, (double)best);
+            }
+            double m = rows, n = features, classes = BENCHMARK_CLASSES;
+
+            // Every epoch: logits X_B*W and gradient X_B^T*(P - Y) (4mnK), the row softmax (about 
+            // 4 operations per logit); X is read once per epoch, the batches stay in cache
+            BenchmarkResult result = {"softmax_regression_train", rows, features, BENCHMARK_EPOCHS, 0, 
+                                      BENCHMARK_EPOCHS*(4*m*n*classes + 4*m*classes), BENCHMARK_EPOCHS*(8*m*n + 8*m)};
+            result.seconds = benchmark_time(run_train, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            // Prediction: X*W and the row softmax, probabilities and labels written
+            result.function = "softmax_regression_predict";
+            result.passes = 1;
+            result.flops = 2*m*n*classes + 4*m*classes;
+            result.bytes = 8*m*n + 8*m*classes + 8*m;
+            result.seconds = benchmark_time(run_predict, &c, report.repetitions);
+            benchmark_print(&report, &result);
+            // Without a probability matrix the rows are scored in tiles and only labels are written
+            result.function = "softmax_regression_predict (labels)";
+            result.bytes = 8*m*n + 8*m;
+            result.seconds = benchmark_time(run_predict_labels, &c, report.repetitions);
+            benchmark_print(&report, &result);
+
+            gsl_matrix_free(c.x_data);
+            gsl_vector_free(c.y_data);
+            gsl_matrix_free(c.probability_set);
+            gsl_vector_free(c.prediction_set);
+            gsl_matrix_free(c.weight_set);
+        }
+    }
+    benchmark_end(&report);
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// GSL headers necessary for linear algebra with scope to this model
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <math.h>
+
+#include "softmax_regression.h"
+
+// Rows scored at a time by softmax_regression_predict when it has no probability matrix to work in
+#define SOFTMAX_TILE_ROWS 256
+
+void softmax_train_options_default(SoftmaxTrainOptions *options){
+    options->batch_size = 256;
+    options->epochs = 100;
+    options->learning_rate = 0.1;
+    options->l2_regularisation = 0.0;
+    options->loss_tolerance = 0.0;
+}
+
+/*
+Fused softmax over the rows of logits (a view, any row stride), in place:
+  max_k = max_j l_j,  s = Σ_j exp(l_j - max_k),  p_j = exp(l_j - max_k)/s
+The shift by the maximum keeps every exponent <= 0, and log-sum-exp = max_k + log(s) gives the
+loss -log(p_y) = log-sum-exp - l_y without ever forming log of a rounded probability.
+With y_data the loss is added to *loss and 1 is subtracted at the true class, leaving P - Y.
+With prediction_set the argmax of every row is stored.
+ */
+static void softmax_rows(gsl_matrix *logits, gsl_vector *y_data, double *loss, gsl_vector *prediction_set){
+    size_t classes = logits->size2;
+    for(size_t i=0;i<logits->size1;i++){
+        double *row = logits->data + i*logits->tda;
+        size_t best = 0;
+        for(size_t k=1;k<classes;k++){
+            if(row[k] > row[best]) best = k;
+        }
+        double row_max = row[best];
+        double true_logit = y_data ? row[(size_t)gsl_vector_get(y_data, i)] : 0;
+        double sum = 0;
+        for(size_t k=0;k<classes;k++){
+            row[k] = exp(row[k] - row_max);
+            sum += row[k];
+        }
+        double scale = 1/sum;
+        for(size_t k=0;k<classes;k++) row[k] *= scale;
+        if(y_data){
+            *loss += row_max + log(sum) - true_logit;
+            row[(size_t)gsl_vector_get(y_data, i)] -= 1.0;
+        }
+        if(prediction_set) gsl_vector_set(prediction_set, i, (double)best);
+    }
+}
+
+unsigned int softmax_regression_train(gsl_vector *y_data, gsl_matrix *x_data, gsl_matrix *weight_set, SoftmaxTrainOptions *options, unsigned int *epochs_run, double *final_loss){
+    size_t m = x_data->size1; // number of data points (rows)
+    size_t n = x_data->size2; // number of features (columns)
+    size_t classes = weight_set->size2;
+    if(epochs_run) *epochs_run = 0;
+    if(m==0 || y_data->size!=m || weight_set->size1!=n || classes<2) return 2; // 2 is for arithmatic error
+    for(size_t i=0;i<m;i++){
+        double label = gsl_vector_get(y_data, i);
+        if(!(label >= 0 && label < (double)classes) || label != floor(label)) return 2;
+    }
+
+    size_t batch_size = (options->batch_size == 0 || options->batch_size > m) ? m : options->batch_size;
+    gsl_matrix *logits = gsl_matrix_alloc(batch_size, classes);
+    gsl_matrix *gradient = gsl_matrix_alloc(n, classes);
+    if(!logits||!gradient){
+        if(logits) gsl_matrix_free(logits);
+        if(gradient) gsl_matrix_free(gradient);
+        return 1; // 1 is for system error
+    }
+
+    double previous_loss = 0;
+    for(unsigned int epoch=0;epoch<options->epochs;epoch++){
+        double loss = 0;
+        for(size_t start=0;start<m;start+=batch_size){
+            size_t rows = (m - start < batch_size) ? m - start : batch_size;
+            gsl_matrix_view x_batch = gsl_matrix_submatrix(x_data, start, 0, rows, n);
+            gsl_vector_view y_batch = gsl_vector_subvector(y_data, start, rows);
+            gsl_matrix_view batch_logits = gsl_matrix_submatrix(logits, 0, 0, rows, classes);
+
+            // L = X_B * W, all classes at once
+            gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &x_batch.matrix, weight_set, 0.0, &batch_logits.matrix);
+            // L -> P - Y
+            softmax_rows(&batch_logits.matrix, &y_batch.vector, &loss, NULL);
+            // gradient = (1/|B|) * X_B^T * (P - Y)
+            gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0/rows, &x_batch.matrix, &batch_logits.matrix, 0.0, gradient);
+
+            // W = (1 - α*λ)*W - α*gradient
+            if(options->l2_regularisation != 0) gsl_matrix_scale(weight_set, 1.0 - options->learning_rate*options->l2_regularisation);
+            gsl_matrix_scale(gradient, options->learning_rate);
+            gsl_matrix_sub(weight_set, gradient);
+        }
+        loss /= m;
+        if(epochs_run) *epochs_run = epoch + 1;
+        if(final_loss) *final_loss = loss;
+        if(epoch > 0 && options->loss_tolerance > 0 && fabs(previous_loss - loss) < options->loss_tolerance) break;
+        previous_loss = loss;
+    }
+
+    gsl_matrix_free(logits);
+    gsl_matrix_free(gradient);
+    return 0;
+}
+
+unsigned int softmax_regression_predict(gsl_matrix *probability_set, gsl_vector *prediction_set, gsl_matrix *weight_set, gsl_matrix *x_data){
+    size_t m = x_data->size1;
+    size_t classes = weight_set->size2;
+    if(weight_set->size1 != x_data->size2) return 2;
+    if(probability_set && (probability_set->size1 != m || probability_set->size2 != classes)) return 2;
+    if(prediction_set && prediction_set->size != m) return 2;
+    if(m == 0) return 0;
+
+    if(probability_set){
+        // One product for the whole batch, then the kernel in place
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, x_data, weight_set, 0.0, probability_set);
+        softmax_rows(probability_set, NULL, NULL, prediction_set);
+        return 0;
+    }
+    if(!prediction_set) return 0;
+
+    size_t tile_rows = (m < SOFTMAX_TILE_ROWS) ? m : SOFTMAX_TILE_ROWS;
+    gsl_matrix *tile = gsl_matrix_alloc(tile_rows, classes);
+    if(!tile) return 1; // 1 is for system error
+    for(size_t start=0;start<m;start+=tile_rows){
+        size_t rows = (m - start < tile_rows) ? m - start : tile_rows;
+        gsl_matrix_view x_tile = gsl_matrix_submatrix(x_data, start, 0, rows, x_data->size2);
+        gsl_matrix_view tile_logits = gsl_matrix_submatrix(tile, 0, 0, rows, classes);
+        gsl_vector_view tile_predictions = gsl_vector_subvector(prediction_set, start, rows);
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &x_tile.matrix, weight_set, 0.0, &tile_logits.matrix);
+        softmax_rows(&tile_logits.matrix, NULL, NULL, &tile_predictions.vector);
+    }
+    gsl_matrix_free(tile);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOFTMAX_REGRESSION_H
+#define SOFTMAX_REGRESSION_H
+
+// GSL headers necessary for linear algebra with scope to this model
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+/*
+ * Settings of `softmax_regression_train`, fill with `softmax_train_options_default` and change 
+ * what is needed.
+ */
+typedef struct {
+size_t batch_size;          // rows per update step, taken in order (0 or more than the rows means full batch)
+unsigned int epochs;        // maximum number of passes over the data
+double learning_rate;
+double l2_regularisation;   // λ of the penalty (λ/2)*||W||^2, 0 disables it
+double loss_tolerance;      // stop when the epoch's mean loss changes by less than it (0 disables)
+}SoftmaxTrainOptions;
+
+
+/*
+ * Function: softmax_train_options_default
+ */
+
+void softmax_train_options_default(SoftmaxTrainOptions *options);
+/* ----------------------------
+ * This function fills `options` with the defaults: batches of 256 rows, 100 epochs, learning 
+ * rate 0.1, no regularisation and no early stopping.
+ */
+
+
+/*
+ * Function: softmax_regression_train
+ */
+
+unsigned int softmax_regression_train(gsl_vector *y_data, gsl_matrix *x_data, gsl_matrix *weight_set, SoftmaxTrainOptions *options, unsigned int *epochs_run, double *final_loss);
+/* ----------------------------
+ * This function trains a multinomial (softmax) regression model with mini-batch gradient descent.
+ * Every class k has its own weight column w_k, the probability of class k for a row x is
+ *    p_k = exp(x^T w_k) / Σ_j exp(x^T w_j)
+ * and the weights minimise the mean cross entropy -(1/m) Σ_i log(p_{y_i}) (+ (λ/2)*||W||^2).
+ *
+ * For every batch of rows X_B the logits of all classes come from one matrix product 
+ * L = X_B * W, each row of L is turned into probabilities in place by a fused log-sum-exp kernel 
+ * (row maximum, exponentials and their sum, normalisation and loss in one sweep, with the maximum 
+ * subtracted so exp never overflows), the true class gets 1 subtracted, and the gradient is a 
+ * second matrix product:
+ *    gradient = (1/|B|) * X_B^T * (P - Y) + λ*W
+ * So all classes are trained in a single pass over the data instead of one pass per class as 
+ * with one-vs-rest logistic regression.
+ *
+ * Arguments:
+ *    - y_data: A pointer to a `gsl_vector` of the m class labels, whole numbers 0 to K-1.
+ *    - x_data: A pointer to a `gsl_matrix` (m x n) of features (add a column of ones for biases).
+ *    - weight_set: A pointer to a `gsl_matrix` (n x K) of initial weights, updated in place.
+ *    - options: A pointer to the settings.
+ *    - epochs_run: Receives the number of epochs performed, may be NULL.
+ *    - final_loss: Receives the mean cross entropy of the last epoch (measured while its batches 
+ *      were processed, without the penalty), may be NULL.
+ *
+ * Returns:
+ *    - 0 if training completes successfully.
+ *    - 1 if memory allocation fails.
+ *    - 2 if a dimension does not match or a label is not a whole number from 0 to K-1.
+ */
+
+
+/*
+ * Function: softmax_regression_predict
+ */
+
+unsigned int softmax_regression_predict(gsl_matrix *probability_set, gsl_vector *prediction_set, gsl_matrix *weight_set, gsl_matrix *x_data);
+/* ----------------------------
+ * This function scores a batch of rows: the logits of all rows and classes come from one matrix 
+ * product X * W, and the fused kernel turns every row into class probabilities and its most 
+ * likely class.
+ *
+ * Arguments:
+ *    - probability_set: A pointer to a `gsl_matrix` (m x K) receiving the class probabilities, 
+ *      or NULL when only the labels are needed (the rows are then scored in tiles of a few 
+ *      hundred rows).
+ *    - prediction_set: A pointer to a `gsl_vector` (m) receiving the most likely class of every 
+ *      row, or NULL.
+ *    - weight_set: A pointer to the trained `gsl_matrix` (n x K) of weights.
+ *    - x_data: A pointer to the `gsl_matrix` (m x n) of rows to score.
+ *
+ * Returns:
+ *    - 0 if prediction completes successfully.
+ *    - 1 if memory allocation fails.
+ *    - 2 if a dimension does not match.
+ */
+
+#endif // SOFTMAX_REGRESSION_H
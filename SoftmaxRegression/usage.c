@@ -0,0 +1,87 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+// GSL headers necessary for linear algebra with scope to this model
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "softmax_regression.h"
+
+int main() {
+    // 3 classes of 100 points each, centred at (0,0), (4,0) and (0,4), with a bias column
+    size_t per_class = 100, classes = 3, features = 3;
+    size_t m = per_class*classes;
+    double centres[3][2] = {{0, 0}, {4, 0}, {0, 4}};
+    gsl_matrix *x_data = gsl_matrix_alloc(m, features);
+    gsl_vector *y_data = gsl_vector_alloc(m);
+    gsl_matrix *weight_set = gsl_matrix_calloc(features, classes);
+    gsl_matrix *probability_set = gsl_matrix_alloc(m, classes);
+    gsl_vector *prediction_set = gsl_vector_alloc(m);
+
+    srand(7);
+    for (size_t i = 0; i < m; i++) {
+        size_t label = i % classes;
+        gsl_matrix_set(x_data, i, 0, 1.0);
+        gsl_matrix_set(x_data, i, 1, centres[label][0] + 2.0*((double)rand()/RAND_MAX - 0.5));
+        gsl_matrix_set(x_data, i, 2, centres[label][1] + 2.0*((double)rand()/RAND_MAX - 0.5));
+        gsl_vector_set(y_data, i, (double)label);
+    }
+
+    // Train the model
+    SoftmaxTrainOptions options;
+    softmax_train_options_default(&options);
+    options.batch_size = 32;
+    options.epochs = 200;
+    unsigned int epochs_run;
+    double loss;
+    unsigned int result = softmax_regression_train(y_data, x_data, weight_set, &options, &epochs_run, &loss);
+    if (result != 0) {
+        printf("Training failed with error code: %u\n", result);
+        return 1;
+    }
+    printf("Training successful after %u epochs, cross entropy %.4f\n", epochs_run, loss);
+
+    // Predict on the training points
+    result = softmax_regression_predict(probability_set, prediction_set, weight_set, x_data);
+    if (result != 0) {
+        printf("Prediction failed with error code: %u\n", result);
+        return 1;
+    }
+    size_t correct = 0;
+    for (size_t i = 0; i < m; i++) {
+        if (gsl_vector_get(prediction_set, i) == gsl_vector_get(y_data, i)) correct++;
+    }
+    printf("Accuracy: %zu / %zu\n", correct, m);
+    for (size_t i = 0; i < 3; i++) {
+        printf("Sample %zu: P = (%.3f, %.3f, %.3f), predicted %.0f, true %.0f\n", i,
+               gsl_matrix_get(probability_set, i, 0), gsl_matrix_get(probability_set, i, 1),
+               gsl_matrix_get(probability_set, i, 2), gsl_vector_get(prediction_set, i), gsl_vector_get(y_data, i));
+    }
+
+    gsl_matrix_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_matrix_free(weight_set);
+    gsl_matrix_free(probability_set);
+    gsl_vector_free(prediction_set);
+    return 0;
+}
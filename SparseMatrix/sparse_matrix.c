@@ -0,0 +1,253 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define _GNU_SOURCE // getline
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+
+#include "sparse_matrix.h"
+
+CSRMatrix *csr_alloc(size_t rows, size_t columns, size_t nnz){
+    CSRMatrix *matrix = calloc(1, sizeof(CSRMatrix));
+    if(!matrix)return NULL;
+    matrix->rows = rows;
+    matrix->columns = columns;
+    matrix->nnz = nnz;
+    matrix->row_offsets = calloc(rows + 1, sizeof(size_t));
+    // Room for at least one entry so an all zero matrix still has valid arrays
+    matrix->column_indices = malloc((nnz ? nnz : 1)*sizeof(size_t));
+    matrix->values = malloc((nnz ? nnz : 1)*sizeof(double));
+    if(!matrix->row_offsets||!matrix->column_indices||!matrix->values){
+        csr_free(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+void csr_free(CSRMatrix *matrix){
+    if(!matrix)return;
+    free(matrix->row_offsets);
+    free(matrix->column_indices);
+    free(matrix->values);
+    free(matrix);
+}
+
+CSRMatrix *csr_from_dense(gsl_matrix *dense){
+    size_t nnz = 0;
+    for(size_t i=0;i<dense->size1;i++){
+        for(size_t j=0;j<dense->size2;j++){
+            if(gsl_matrix_get(dense, i, j) != 0) nnz++;
+        }
+    }
+    CSRMatrix *matrix = csr_alloc(dense->size1, dense->size2, nnz);
+    if(!matrix)return NULL;
+    size_t k = 0;
+    for(size_t i=0;i<dense->size1;i++){
+        for(size_t j=0;j<dense->size2;j++){
+            double value = gsl_matrix_get(dense, i, j);
+            if(value == 0) continue;
+            matrix->column_indices[k] = j;
+            matrix->values[k] = value;
+            k++;
+        }
+        matrix->row_offsets[i+1] = k;
+    }
+    return matrix;
+}
+
+/*
+Parses one libsvm line. With matrix NULL it only counts the entries (into *entries) and the
+largest index (into *max_index); otherwise it writes the entries from position *entries on,
+never at or past matrix->nnz.
+Returns 0 for a row, 1 for a blank or comment line, 2 for a malformed line, 3 if the row does
+not fit into matrix.
+ */
+static int libsvm_parse_line(char *line, double *label, size_t column_shift, size_t number_of_features, CSRMatrix *matrix, size_t *entries, size_t *max_index){
+    char *comment = strchr(line, '#');
+    if(comment) *comment = '\0';
+    char *cursor = line;
+    while(isspace((unsigned char)*cursor)) cursor++;
+    if(*cursor == '\0') return 1;
+
+    char *end;
+    *label = strtod(cursor, &end);
+    if(end == cursor) return 2;
+    cursor = end;
+
+    size_t previous_index = 0;
+    for(;;){
+        while(isspace((unsigned char)*cursor)) cursor++;
+        if(*cursor == '\0') break;
+        unsigned long long index = strtoull(cursor, &end, 10);
+        if(end == cursor || *end != ':' || index <= previous_index) return 2;
+        if(number_of_features && index > number_of_features) return 2;
+        cursor = end + 1;
+        double value = strtod(cursor, &end);
+        if(end == cursor) return 2;
+        cursor = end;
+        previous_index = index;
+        if(value == 0) continue;
+        if(matrix){
+            if(*entries == matrix->nnz) return 3;
+            matrix->column_indices[*entries] = (size_t)index - 1 + column_shift;
+            matrix->values[*entries] = value;
+        }
+        (*entries)++;
+    }
+    if(max_index && previous_index > *max_index) *max_index = previous_index;
+    return 0;
+}
+
+unsigned int csr_load_libsvm(const char *path, size_t number_of_features, int add_bias_column, CSRMatrix **x_data, gsl_vector **y_data){
+    *x_data = NULL;
+    *y_data = NULL;
+    FILE *file = fopen(path, "r");
+    if(!file)return 1; // 1 is for system error
+
+    unsigned int status = 0;
+    char *line = NULL;
+    size_t line_capacity = 0;
+    size_t column_shift = add_bias_column ? 1 : 0;
+    double label;
+
+    // Pass 1: rows, entries and the largest index
+    size_t rows = 0, entries = 0, max_index = 0;
+    while(getline(&line, &line_capacity, file) != -1){
+        int parsed = libsvm_parse_line(line, &label, column_shift, number_of_features, NULL, &entries, &max_index);
+        if(parsed == 2){
+            status = 2; // 2 is for format error
+            goto cleanup;
+        }
+        if(parsed == 0) rows++;
+    }
+    if(ferror(file)){
+        status = 1;
+        goto cleanup;
+    }
+    if(rows == 0){
+        status = 2; // no data rows, a gsl_vector cannot hold 0 targets
+        goto cleanup;
+    }
+    if(number_of_features == 0) number_of_features = max_index;
+
+    size_t bias_entries = add_bias_column ? rows : 0;
+    *x_data = csr_alloc(rows, number_of_features + column_shift, entries + bias_entries);
+    *y_data = gsl_vector_alloc(rows);
+    if(!*x_data||!*y_data){
+        status = 1;
+        goto cleanup;
+    }
+
+    // Pass 2: fill the arrays
+    rewind(file);
+    size_t row = 0, position = 0;
+    while(row < rows && getline(&line, &line_capacity, file) != -1){
+        if(add_bias_column){
+            if(position == (*x_data)->nnz){
+                status = 1; // the file changed between the passes
+                goto cleanup;
+            }
+            (*x_data)->column_indices[position] = 0;
+            (*x_data)->values[position] = 1.0;
+            position++;
+        }
+        int parsed = libsvm_parse_line(line, &label, column_shift, number_of_features, *x_data, &position, NULL);
+        if(parsed == 2){
+            status = 2;
+            goto cleanup;
+        }
+        if(parsed == 3){
+            status = 1; // the file changed between the passes
+            goto cleanup;
+        }
+        if(parsed == 1){
+            if(add_bias_column) position--;
+            continue;
+        }
+        gsl_vector_set(*y_data, row, label);
+        (*x_data)->row_offsets[row+1] = position;
+        row++;
+    }
+    if(row != rows){
+        status = 1; // the file changed between the passes
+    }
+
+cleanup:
+    free(line);
+    fclose(file);
+    if(status != 0){
+        csr_free(*x_data);
+        if(*y_data)gsl_vector_free(*y_data);
+        *x_data = NULL;
+        *y_data = NULL;
+    }
+    return status;
+}
+
+void csr_dgemv(CBLAS_TRANSPOSE_t transpose, double alpha, CSRMatrix *a, gsl_vector *x, double beta, gsl_vector *y){
+    if(transpose == CblasNoTrans){
+        for(size_t i=0;i<a->rows;i++){
+            double sum = 0;
+            for(size_t k=a->row_offsets[i];k<a->row_offsets[i+1];k++){
+                sum += a->values[k]*gsl_vector_get(x, a->column_indices[k]);
+            }
+            double previous = (beta == 0) ? 0 : beta*gsl_vector_get(y, i);
+            gsl_vector_set(y, i, alpha*sum + previous);
+        }
+        return;
+    }
+    // Transposed: scale y once, then scatter every row into it
+    if(beta == 0) gsl_vector_set_zero(y);
+    else if(beta != 1) gsl_vector_scale(y, beta);
+    for(size_t i=0;i<a->rows;i++){
+        double scale = alpha*gsl_vector_get(x, i);
+        if(scale == 0) continue;
+        for(size_t k=a->row_offsets[i];k<a->row_offsets[i+1];k++){
+            size_t column = a->column_indices[k];
+            gsl_vector_set(y, column, gsl_vector_get(y, column) + scale*a->values[k]);
+        }
+    }
+}
+
+void csr_gram(CSRMatrix *a, gsl_matrix *gram){
+    gsl_matrix_set_zero(gram);
+    // Lower triangle only (columns are increasing within a row), mirrored at the end
+    for(size_t i=0;i<a->rows;i++){
+        for(size_t k=a->row_offsets[i];k<a->row_offsets[i+1];k++){
+            size_t row = a->column_indices[k];
+            double value = a->values[k];
+            double *gram_row = gram->data + row*gram->tda;
+            for(size_t l=a->row_offsets[i];l<=k;l++){
+                gram_row[a->column_indices[l]] += value*a->values[l];
+            }
+        }
+    }
+    for(size_t r=0;r<gram->size1;r++){
+        for(size_t c=0;c<r;c++){
+            gsl_matrix_set(gram, c, r, gsl_matrix_get(gram, r, c));
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <stddef.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * Type: CSRMatrix
+ * ----------------------------
+ * A sparse matrix in Compressed Sparse Row form. Only the non zero entries are stored, row after 
+ * row: the entries of row i are values[k] in column column_indices[k] for 
+ * row_offsets[i] <= k < row_offsets[i+1]. Column indices within a row are increasing.
+ *
+ * For example
+ *    [ 5 0 0 ]
+ *    [ 0 0 3 ]      row_offsets = {0, 1, 2, 4}, column_indices = {0, 2, 0, 1}, values = {5, 3, 1, 2}
+ *    [ 1 2 0 ]
+ */
+typedef struct {
+size_t rows;
+size_t columns;
+size_t nnz;                 // number of stored entries
+size_t *row_offsets;        // rows + 1 entries, row_offsets[rows] == nnz
+size_t *column_indices;     // nnz entries
+double *values;             // nnz entries
+}CSRMatrix;
+
+
+/*
+ * Function: csr_alloc
+ * ----------------------------
+ */
+CSRMatrix *csr_alloc(size_t rows, size_t columns, size_t nnz);
+/* This function allocates a CSR matrix with room for `nnz` entries. The arrays are left 
+ * uninitialised except row_offsets, which is all zeros; the caller fills them.
+ *
+ * Returns:
+ *    - A pointer to the matrix, to be released with `csr_free`.
+ *    - `NULL` if an allocation failed.
+ */
+
+
+/*
+ * Function: csr_free
+ * ----------------------------
+ */
+void csr_free(CSRMatrix *matrix);
+/* This function frees a matrix created by this module. Passing `NULL` does nothing.
+ */
+
+
+/*
+ * Function: csr_from_dense
+ * ----------------------------
+ */
+CSRMatrix *csr_from_dense(gsl_matrix *dense);
+/* This function converts a dense `gsl_matrix` into CSR form, keeping only its non zero entries.
+ *
+ * Returns:
+ *    - A pointer to the new matrix, to be released with `csr_free`.
+ *    - `NULL` if an allocation failed.
+ */
+
+
+/*
+ * Function: csr_load_libsvm
+ * ----------------------------
+ */
+unsigned int csr_load_libsvm(const char *path, size_t number_of_features, int add_bias_column, CSRMatrix **x_data, gsl_vector **y_data);
+/* This function reads a file in the sparse text format of LIBSVM / SVMlight, one row per line:
+ *    <label> <index>:<value> <index>:<value> ...
+ * with increasing indices starting at 1, and anything after a '#' ignored. Blank lines are skipped.
+ * The file is read twice, once to count the rows and entries and once to fill the arrays, so the 
+ * memory used is exactly that of the non zero entries.
+ *
+ * Arguments:
+ *    - path: The file to read.
+ *    - number_of_features: The number of feature columns, or 0 to use the largest index in the file.
+ *    - add_bias_column: 1 to add a column 0 of ones (the intercept column); feature index k then 
+ *      goes to column k, otherwise to column k-1.
+ *    - x_data: Receives the new feature matrix, to be released with `csr_free`.
+ *    - y_data: Receives a new `gsl_vector` of the labels, to be released with `gsl_vector_free`. 
+ *      Labels are stored as written, binary files often use -1/+1 where logistic regression 
+ *      expects 0/1.
+ *
+ * Returns:
+ *    - `0` if the file was read.
+ *    - `1` if the file could not be read, an allocation failed or the file changed between the 
+ *      two passes (nothing is written past the arrays sized by the first).
+ *    - `2` if the file has no data rows, or a line is malformed, an index is 0, not increasing, 
+ *      or above `number_of_features`.
+ */
+
+
+/*
+ * Function: csr_dgemv
+ * ----------------------------
+ */
+void csr_dgemv(CBLAS_TRANSPOSE_t transpose, double alpha, CSRMatrix *a, gsl_vector *x, double beta, gsl_vector *y);
+/* This function is the sparse counterpart of `gsl_blas_dgemv`:
+ *    y = alpha * A * x + beta * y        with CblasNoTrans (x has a->columns entries, y a->rows)
+ *    y = alpha * A^T * x + beta * y      with CblasTrans (x has a->rows entries, y a->columns)
+ * Only stored entries are visited, so the cost is O(nnz) plus the length of y.
+ */
+
+
+/*
+ * Function: csr_gram
+ * ----------------------------
+ */
+void csr_gram(CSRMatrix *a, gsl_matrix *gram);
+/* This function computes the dense (columns x columns) matrix gram = A^T * A by adding the 
+ * outer product of every sparse row with itself. The cost is the sum over the rows of the 
+ * squared number of entries in the row, plus clearing `gram`.
+ */
+
+#endif // SPARSE_MATRIX_H
@@ -0,0 +1,86 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+// GSL headers necessary for linear algebra with scope to this model
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "sparse_matrix.h"
+#include "../LogisticRegression/logistic_regression.h"
+
+int main(int argc, char **argv) {
+    CSRMatrix *x_data;
+    gsl_vector *y_data;
+
+    if (argc > 1) {
+        // Train on a LIBSVM file, with a bias column in front of its features
+        unsigned int result = csr_load_libsvm(argv[1], 0, 1, &x_data, &y_data);
+        if (result != 0) {
+            printf("Could not load %s, error code: %u\n", argv[1], result);
+            return 1;
+        }
+        // LIBSVM binary labels are often -1/+1
+        for (size_t i = 0; i < y_data->size; i++) {
+            gsl_vector_set(y_data, i, gsl_vector_get(y_data, i) > 0 ? 1.0 : 0.0);
+        }
+    } else {
+        // Small one-hot example: bias, then 4 categories of which only the last two mean class 1
+        size_t rows = 8, columns = 5;
+        gsl_matrix *dense = gsl_matrix_calloc(rows, columns);
+        y_data = gsl_vector_alloc(rows);
+        for (size_t i = 0; i < rows; i++) {
+            size_t category = i % 4;
+            gsl_matrix_set(dense, i, 0, 1.0);
+            gsl_matrix_set(dense, i, 1 + category, 1.0);
+            gsl_vector_set(y_data, i, category >= 2 ? 1.0 : 0.0);
+        }
+        x_data = csr_from_dense(dense);
+        gsl_matrix_free(dense);
+        if (!x_data) {
+            printf("Could not convert the matrix\n");
+            return 1;
+        }
+    }
+    printf("Rows: %zu, columns: %zu, stored entries: %zu (%.2f%% of the matrix)\n", x_data->rows, x_data->columns,
+           x_data->nnz, 100.0*x_data->nnz/((double)x_data->rows*x_data->columns));
+
+    gsl_vector *weight_set = gsl_vector_calloc(x_data->columns);
+    gsl_vector *prediction_set = gsl_vector_alloc(x_data->rows);
+    unsigned int result = logistic_regression_train_csr(y_data, x_data, weight_set, 0.5, 1000);
+    if (result != 0) {
+        printf("Training failed with error code: %u\n", result);
+        return 1;
+    }
+    logistic_regression_predict_csr(prediction_set, weight_set, x_data);
+    size_t correct = 0;
+    for (size_t i = 0; i < x_data->rows; i++) {
+        if (gsl_vector_get(prediction_set, i) == gsl_vector_get(y_data, i)) correct++;
+    }
+    printf("Training accuracy: %zu / %zu\n", correct, x_data->rows);
+
+    csr_free(x_data);
+    gsl_vector_free(y_data);
+    gsl_vector_free(weight_set);
+    gsl_vector_free(prediction_set);
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+
+#include "training_telemetry.h"
+
+double telemetry_now(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+double telemetry_lap(TrainingTelemetry *telemetry, TelemetryPhase phase, double start){
+    if(!telemetry) return 0;
+    double now = telemetry_now();
+    telemetry->phase_seconds[phase] += now - start;
+    return now;
+}
+
+void telemetry_reset(TrainingTelemetry *telemetry){
+    for(int phase=0;phase<TELEMETRY_PHASES;phase++) telemetry->phase_seconds[phase] = 0;
+    telemetry->iterations = 0;
+    telemetry->samples = 0;
+    telemetry->bytes_touched = 0;
+    telemetry->allocations = 0;
+    telemetry->aborted = 0;
+}
+
+int telemetry_record(TrainingTelemetry *telemetry, unsigned int iteration, double loss, double gradient_norm){
+    TelemetrySample sample = {iteration, loss, gradient_norm};
+    if(telemetry->history && telemetry->samples < telemetry->history_capacity) telemetry->history[telemetry->samples] = sample;
+    telemetry->samples++;
+    if(telemetry->callback && telemetry->callback(&sample, telemetry->user_data)){
+        telemetry->aborted = 1;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Apache License
+ * Version 2.0, January 2004
+ * http://www.apache.org/licenses/
+ * 
+ * Copyright 2025 Swapnaneel Dutta
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRAINING_TELEMETRY_H
+#define TRAINING_TELEMETRY_H
+
+#include <stddef.h>
+
+/*
+ * Telemetry filled by the `_instrumented` training functions of the models (e.g. 
+ * `mlr_train_instrumented`, `logistic_regression_train_instrumented`): where the time went, how 
+ * the loss developed, how much memory was streamed and allocated, and a callback that can stop 
+ * training early. The plain training functions share the same code with telemetry switched off: 
+ * every clock read and phase update is behind an `if(telemetry)`, so that costs a few 
+ * predictable branches per iteration and no call into this module.
+ */
+
+typedef enum {
+TELEMETRY_GRAM,         // X^T X and X^T y products of the normal equation
+TELEMETRY_CHOLESKY,     // Cholesky factorisation of X^T X + λI
+TELEMETRY_SOLVE,        // inversion and product giving the coefficients
+TELEMETRY_ITERATIONS,   // gradient descent iterations (products, activation, update, samples)
+TELEMETRY_PRODUCTS,     // part of TELEMETRY_ITERATIONS: the X*β and X^T*error products
+TELEMETRY_UPDATE,       // part of TELEMETRY_ITERATIONS: activation, error and coefficient update
+TELEMETRY_PHASES        // number of phases
+}TelemetryPhase;
+
+typedef struct {
+unsigned int iteration;     // zero based iteration the sample was taken in
+double loss;                // loss at the weights the iteration started from (MSE or mean cross entropy)
+double gradient_norm;       // Euclidean norm of the gradient at the same weights
+}TelemetrySample;
+
+// Receives every sample, returns non zero to stop training before the sampled iteration updates the weights
+typedef int (*telemetry_callback)(const TelemetrySample *sample, void *user_data);
+
+typedef struct {
+// Settings, chosen by the caller
+unsigned int sample_stride;     // take a sample every this many iterations (0 takes none)
+telemetry_callback callback;    // called with every sample, may be NULL
+void *user_data;                // passed to the callback
+TelemetrySample *history;       // array receiving the samples, may be NULL
+size_t history_capacity;        // samples the history can hold, later ones are not stored
+
+// Results, cleared and filled by the training function
+double phase_seconds[TELEMETRY_PHASES];  // wall time spent in each phase
+unsigned int iterations;                 // iterations performed
+size_t samples;                          // samples taken (also those not stored)
+unsigned long long bytes_touched;        // data streamed from and to memory, counted from the algorithm
+unsigned int allocations;                // heap allocations made by the call
+int aborted;                             // 1 if the callback stopped training
+}TrainingTelemetry;
+
+/*
+ * Helpers for the training functions that fill a TrainingTelemetry (see training_telemetry.c).
+ */
+
+// Monotonic wall clock in seconds
+double telemetry_now(void);
+
+// Adds the time since start to the phase and returns the current time; does nothing and returns 0 when telemetry is NULL
+double telemetry_lap(TrainingTelemetry *telemetry, TelemetryPhase phase, double start);
+
+// Clears the results of telemetry, keeping the settings
+void telemetry_reset(TrainingTelemetry *telemetry);
+
+// Stores a sample and passes it to the callback; returns 1 (and sets aborted) if the callback asks to stop
+int telemetry_record(TrainingTelemetry *telemetry, unsigned int iteration, double loss, double gradient_norm);
+
+#endif // TRAINING_TELEMETRY_H